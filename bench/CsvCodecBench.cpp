@@ -0,0 +1,124 @@
+// Compares the getline/stringstream CSV path with CsvCodec on 12-key and 10k-key files.
+//
+//     ./CsvCodecBench [iterations scale]
+//
+// Every case reports the mean time per file and the heap allocations per file.
+#include "StateStorage.h"
+#include "CsvCodec.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+// The implementation CsvStorage used before the codec
+static CSVMap legacyLoad(const std::string& filename) {
+    std::ifstream infile(filename);
+    CSVMap data;
+    std::string line, key, value;
+    std::getline(infile, line); // Skip header
+    while (std::getline(infile, line)) {
+        std::stringstream ss(line);
+        if (std::getline(ss, key, ',') && std::getline(ss, value)) {
+            data[key] = value;
+        }
+    }
+    return data;
+}
+
+static bool legacyPersist(const std::string& filename, const CSVMap& data) {
+    std::ofstream outfile(filename);
+    outfile << "key,value" << std::endl;
+    for (const auto& [k, v] : data) {
+        outfile << k << "," << v << std::endl;
+    }
+    return true;
+}
+
+static void runCase(const std::string& name, int iterations, const std::function<void()>& body) {
+    body(); // warm up buffers and the page cache
+    uint64_t allocationsBefore = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        body();
+    }
+    double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    double allocationsPerFile = static_cast<double>(allocations.load() - allocationsBefore) / iterations;
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << elapsedUs / iterations << " us/file" << std::setw(12) << allocationsPerFile
+              << " allocs/file" << std::endl;
+}
+
+static void benchmark(const std::string& label, const CSVMap& data, const SignalFrame& frame, int iterations) {
+    const std::string path = "CsvCodecBench.csv";
+    const std::string outPath = "CsvCodecBench.out.csv";
+    CsvStorage(path).persist(data);
+
+    CsvStorage storage(path);
+    CsvStorage output(outPath);
+    std::string buffer;
+    size_t sink = 0;
+
+    std::cout << label << " (" << data.size() << " keys, " << iterations << " iterations)" << std::endl;
+    runCase("parse: getline/stringstream", iterations, [&] { sink += legacyLoad(path).size(); });
+    runCase("parse: codec -> CSVMap", iterations, [&] { sink += storage.load().size(); });
+    runCase("parse: codec -> string_view", iterations, [&] {
+        readFile(path, buffer);
+        sink += parseCsv(buffer, [&](std::string_view key, std::string_view value) { sink += key.size() + value.size(); });
+    });
+    if (!frame.presentMask) {
+        runCase("write: ofstream + endl", iterations, [&] { legacyPersist(outPath, data); });
+        runCase("write: codec single write()", iterations, [&] { output.persist(data); });
+    } else {
+        SignalFrame loaded;
+        CSVMap extras;
+        runCase("parse: codec -> SignalFrame", iterations, [&] { storage.loadFrame(loaded, extras); });
+        runCase("write: ofstream + endl", iterations, [&] { legacyPersist(outPath, data); });
+        runCase("write: codec single write()", iterations, [&] { output.persist(data); });
+        runCase("write: codec SignalFrame", iterations, [&] { output.persistFrame(frame, {}); });
+    }
+    std::remove(path.c_str());
+    std::remove(outPath.c_str());
+    if (sink == 0) {
+        std::cerr << "Benchmark read no data" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+
+    CSVMap vehicle;
+    SignalFrame frame;
+    for (const auto& info : SIGNALS) {
+        double value = static_cast<double>(info.id) * 17.25;
+        if (info.type != SignalType::REAL) value = static_cast<int>(value) % 2;
+        frame.set(info.id, value);
+        vehicle[info.csvName] = formatSignal(info.id, value);
+    }
+    benchmark("Vehicle state", vehicle, frame, 5000 * scale);
+
+    CSVMap large;
+    for (int i = 0; i < 10000; i++) {
+        large["SENSOR_" + std::to_string(i)] = std::to_string(i * 0.125);
+    }
+    benchmark("Large file", large, SignalFrame{}, 50 * scale);
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Drives every built-in DriveCycle headlessly through SpeedCalculator and
+// BatteryManager and reports the kWh/km and range it produced. The gate is
+// deterministic: every run of a cycle must give the same outputs, and over
+// REFERENCE_HOURS the energy, distance and final charge must match the
+// reference values below. Wall time per simulated hour (fastest run) and
+// its spread are printed for information only; they vary too much between
+// runs to gate on.
+//
+//     ./DriveCycleBench [hours] [runs] [cycle ...]
+#include "BatteryManager.h"
+#include "DriveCycle.h"
+#include "VehicleConfig.h"
+#include "VehicleSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct CycleResult {
+    double wallSeconds = 0.0;
+    double simulatedSeconds = 0.0;  // less than asked if the battery ran empty
+    double distance = 0.0;          // km
+    double energy = 0.0;            // kWh drawn from the battery
+    double batteryLevel = 0.0;      // % left at the end
+    double kwhPerKm = 0.0;
+    double range = 0.0;             // km on a full battery at that consumption
+    uint64_t outputHash = 0;        // FNV-1a of every tick's speed and charge
+};
+
+// Tesla long range over REFERENCE_HOURS of each built-in cycle; update when the physics changes on purpose
+struct Reference {
+    const char* cycle;
+    double energy;          // kWh
+    double distance;        // km
+    double batteryLevel;    // %
+};
+
+static const double REFERENCE_HOURS = 1.0;
+static const double RELATIVE_TOLERANCE = 1e-3;     // energy and distance
+static const double LEVEL_TOLERANCE = 0.1;         // percentage points
+static const Reference REFERENCES[] = {
+    {"urban", 8.2819, 64.744, 88.958},
+    {"highway", 75.000, 83.301, 0.000},     // runs empty before the hour is up
+    {"sport", 35.274, 200.358, 52.969},
+    {"wltp", 9.8229, 30.591, 86.903},
+};
+
+static const Reference* findReference(const std::string& cycle) {
+    for (const Reference& reference : REFERENCES) {
+        if (cycle == reference.cycle) return &reference;
+    }
+    return nullptr;
+}
+
+static bool withinRelative(double value, double expected) {
+    return std::abs(value - expected) <= RELATIVE_TOLERANCE * std::max(std::abs(expected), 1.0);
+}
+
+static void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+}
+
+static CycleResult run(const DriveCycle& cycle, double hours) {
+    SimulationClock clock(SimulationClock::Mode::FIXED_STEP);
+    DriveMode driveMode;
+    SafetyManager safetyManager;
+    SpeedCalculator speedCalculator(&driveMode, &safetyManager, &clock);
+    BatteryManager batteryManager(&speedCalculator, &clock);
+    VehicleSimulation simulation(&driveMode, &safetyManager, &speedCalculator, &batteryManager, cycle.inputsAt(0.0));
+
+    CycleResult result;
+    result.outputHash = 14695981039346656037ULL;
+    double capacity = batteryManager.getBatteryKwH();
+    auto start = std::chrono::steady_clock::now();
+    while (clock.getTime() < hours * 3600.0 && batteryManager.getBatteryKwH() > 0.0) {
+        clock.tick();
+        const VehicleState& state = simulation.step(cycle.inputsAt(clock.getTime()));
+        double kwh = batteryManager.getBatteryKwH();
+        hashBytes(result.outputHash, &state.speed, sizeof(state.speed));
+        hashBytes(result.outputHash, &kwh, sizeof(kwh));
+    }
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.simulatedSeconds = clock.getTime();
+    result.distance = speedCalculator.getTotalDistance();
+    result.energy = capacity - batteryManager.getBatteryKwH();
+    result.batteryLevel = batteryManager.getBatteryCapacity();
+    if (result.distance > 0.0) {
+        result.kwhPerKm = (capacity - batteryManager.getBatteryKwH()) / result.distance;
+        result.range = result.kwhPerKm > 0.0 ? capacity / result.kwhPerKm : 0.0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    double hours = argc > 1 ? std::atof(argv[1]) : 1.0;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (hours <= 0.0) hours = 1.0;
+    if (runs < 1) runs = 1;
+
+    std::vector<const DriveCycle*> cycles;
+    for (int i = 3; i < argc; i++) {
+        const DriveCycle* cycle = DriveCycle::find(argv[i]);
+        if (!cycle) {
+            std::cerr << "Unknown drive cycle: " << argv[i] << std::endl;
+            return 1;
+        }
+        cycles.push_back(cycle);
+    }
+    if (cycles.empty()) {
+        for (const DriveCycle& cycle : DriveCycle::builtIn()) cycles.push_back(&cycle);
+    }
+
+    ElectricVehicleInit::load(*VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE));
+    std::cout << "Tesla long range, " << SimulationClock::DEFAULT_STEP * 1000 << " ms ticks, " << hours
+              << " simulated h per cycle, fastest of " << runs << " runs" << std::endl;
+    std::cout << "cycle        pass s  sim h      km  avg km/h    kWh/km  range km  ms/sim h  spread %  output hash"
+              << std::endl;
+
+    bool deterministic = true;
+    bool referenced = hours == REFERENCE_HOURS;
+    std::vector<std::string> regressions;
+    for (const DriveCycle* cycle : cycles) {
+        std::vector<CycleResult> results;
+        for (int r = 0; r < runs; r++) results.push_back(run(*cycle, hours));
+
+        const CycleResult& first = results.front();
+        double fastest = first.wallSeconds;
+        double slowest = first.wallSeconds;
+        for (const CycleResult& result : results) {
+            fastest = std::min(fastest, result.wallSeconds);
+            slowest = std::max(slowest, result.wallSeconds);
+            if (result.outputHash != first.outputHash) deterministic = false;
+        }
+        const Reference* reference = findReference(cycle->getName());
+        if (referenced && reference &&
+            (!withinRelative(first.energy, reference->energy) || !withinRelative(first.distance, reference->distance) ||
+             std::abs(first.batteryLevel - reference->batteryLevel) > LEVEL_TOLERANCE)) {
+            std::ostringstream line;
+            line << cycle->getName() << ": " << first.energy << " kWh, " << first.distance << " km, "
+                 << first.batteryLevel << " % left; expected " << reference->energy << " kWh, " << reference->distance
+                 << " km, " << reference->batteryLevel << " %";
+            regressions.push_back(line.str());
+        }
+        double simulatedHours = first.simulatedSeconds / 3600.0;
+        std::cout << std::left << std::setw(12) << cycle->getName() << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(7) << cycle->getDuration() << std::setprecision(2) << std::setw(7) << simulatedHours
+                  << std::setprecision(1) << std::setw(8) << first.distance << std::setw(10)
+                  << (simulatedHours > 0.0 ? first.distance / simulatedHours : 0.0) << std::setprecision(4)
+                  << std::setw(10) << first.kwhPerKm << std::setprecision(1) << std::setw(10) << first.range
+                  << std::setprecision(2) << std::setw(10) << fastest * 1000.0 / simulatedHours << std::setprecision(1)
+                  << std::setw(10) << (fastest > 0.0 ? 100.0 * (slowest - fastest) / fastest : 0.0) << "  "
+                  << std::hex << std::setw(16) << std::setfill('0') << first.outputHash << std::dec
+                  << std::setfill(' ') << std::endl;
+    }
+    std::cout << "Wall times are for information; the gate is the outputs" << std::endl;
+    if (!referenced) {
+        std::cout << "Reference outputs are for " << REFERENCE_HOURS << " simulated h; not compared" << std::endl;
+    }
+    for (const std::string& regression : regressions) {
+        std::cerr << "Output changed: " << regression << std::endl;
+    }
+    if (!deterministic) {
+        std::cerr << "Runs of the same cycle produced different outputs" << std::endl;
+    }
+    return deterministic && regressions.empty() ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Checks that an external edit of the backing CSV file does not revert
+// local updates the write-behind store has not flushed yet: a local update
+// to one signal and one extra key, then another program rewrites the file
+// with a different signal changed. All three values must survive in memory
+// and in the file after the next flush. Exits 1 otherwise.
+//
+//     ./ExternalMergeCheck
+#include "DataHandler.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+static const char* STORE_PATH = "ExternalMergeCheck.csv";
+
+// Another program: rewrite the whole file, as an editor saving it would
+static bool writeExternally(const CSVMap& data) {
+    std::string temp = std::string(STORE_PATH) + ".tmp";
+    {
+        std::ofstream out(temp);
+        out << "key,value\n";
+        for (const auto& [k, v] : data) out << k << "," << v << "\n";
+        if (!out) return false;
+    }
+    return std::rename(temp.c_str(), STORE_PATH) == 0;
+}
+
+static bool check(bool condition, const char* what) {
+    if (!condition) std::cerr << "FAILED: " << what << std::endl;
+    return condition;
+}
+
+int main() {
+    std::remove(STORE_PATH);
+    bool ok = true;
+    {
+        std::unique_ptr<DataHandler> store = DataHandler::open(STORE_PATH, StorageBackend::CSV, true);
+        if (!store) {
+            return 1;
+        }
+        store->updateSignals({{SignalId::VEHICLE_SPEED, 10}, {SignalId::BATTERY_LEVEL, 80}});
+        store->updateData({{"DRIVER", "nobody"}});
+        store->flush();
+        CSVMap onDisk = CsvStorage(STORE_PATH).load();
+
+        // Local updates that stay in memory until the next flush
+        FlushPolicy slow;
+        slow.interval = std::chrono::seconds(60);
+        slow.dirtyThreshold = 1000;
+        store->setFlushPolicy(slow);
+        store->updateSignals({{SignalId::VEHICLE_SPEED, 42}});
+        store->updateData({{"DRIVER", "local"}});
+
+        // The other program changes only the battery level of what it read from the file
+        onDisk["BATTERY_LEVEL"] = "55";
+        if (!writeExternally(onDisk)) {
+            std::cerr << "Failed to rewrite " << STORE_PATH << std::endl;
+            return 1;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (store->readSignals().get(SignalId::BATTERY_LEVEL) != 55 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        SignalFrame frame = store->readSignals();
+        CSVMap data = store->readData();
+        ok = check(frame.get(SignalId::BATTERY_LEVEL) == 55, "the external battery level was merged") && ok;
+        ok = check(frame.get(SignalId::VEHICLE_SPEED) == 42, "the unflushed local speed survived the merge") && ok;
+        ok = check(data["DRIVER"] == "local", "the unflushed local extra survived the merge") && ok;
+
+        store->flush();
+        CSVMap persisted = CsvStorage(STORE_PATH).load();
+        ok = check(persisted["BATTERY_LEVEL"] == "55", "the file keeps the external battery level") && ok;
+        ok = check(persisted["VEHICLE_SPEED"] == "42", "the file gets the local speed") && ok;
+        ok = check(persisted["DRIVER"] == "local", "the file gets the local extra") && ok;
+        store->shutdown();
+    }
+    std::remove(STORE_PATH);
+    std::cout << "External edit merged with unflushed local updates: " << (ok ? "both kept" : "LOST") << std::endl;
+    return ok ? 0 : 1;
+}
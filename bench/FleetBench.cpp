@@ -0,0 +1,123 @@
+// Steps a fleet of vehicles at 10 Hz across 1..N threads and reports the
+// scaling, after checking that the fleet matches the single-car path.
+//
+//     ./FleetBench [vehicles] [ticks] [max threads]
+#include "BatteryManager.h"
+#include "FleetSimulator.h"
+#include "VehicleConfig.h"
+#include "VehicleSimulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Each vehicle runs the 70 s accelerate / coast / brake / idle cycle with its own offset and settings
+static DriverInputs driveInputs(size_t vehicle, uint64_t tick) {
+    uint64_t cycleSecond = (tick / 10 + vehicle * 7) % 70;
+    DriverInputs inputs;
+    inputs.isAccelerator = cycleSecond < 30 || (vehicle % 11 == 0 && cycleSecond >= 55 && cycleSecond < 57);
+    inputs.isBrake = cycleSecond >= 50 && cycleSecond < 60;
+    inputs.driveMode = ((tick / 600 + vehicle) % 3 == 0) ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    inputs.acStatus = true;
+    inputs.acTemp = 18 + static_cast<int>(vehicle % 8);
+    inputs.windLevel = static_cast<int>(vehicle % 6);
+    return inputs;
+}
+
+// Fleet vehicles against one VehicleSimulation each, bit for bit; the cars keep the default
+// energy-map range, the fleet's range must match their EMA estimate
+static size_t verifyAgainstSingleCar(size_t vehicles, uint64_t ticks) {
+    SimulationClock clock(SimulationClock::Mode::FIXED_STEP, 0.1);
+    ThreadPool pool(1);
+    FleetSimulator fleet(vehicles, &clock, &pool);
+
+    std::vector<std::unique_ptr<DriveMode>> modes;
+    std::vector<std::unique_ptr<SafetyManager>> safety;
+    std::vector<std::unique_ptr<SpeedCalculator>> speeds;
+    std::vector<std::unique_ptr<BatteryManager>> batteries;
+    std::vector<std::unique_ptr<VehicleSimulation>> cars;
+    for (size_t v = 0; v < vehicles; v++) {
+        modes.emplace_back(new DriveMode());
+        safety.emplace_back(new SafetyManager());
+        speeds.emplace_back(new SpeedCalculator(modes[v].get(), safety[v].get(), &clock));
+        batteries.emplace_back(new BatteryManager(speeds[v].get(), &clock));
+        cars.emplace_back(new VehicleSimulation(modes[v].get(), safety[v].get(), speeds[v].get(), batteries[v].get(),
+                                                driveInputs(v, 0)));
+    }
+
+    size_t mismatches = 0;
+    for (uint64_t tick = 0; tick < ticks; tick++) {
+        clock.tick();
+        for (size_t v = 0; v < vehicles; v++) {
+            DriverInputs inputs = driveInputs(v, tick);
+            fleet.setInputs(v, inputs);
+            cars[v]->step(inputs);
+        }
+        fleet.step();
+        for (size_t v = 0; v < vehicles; v++) {
+            const VehicleState& state = cars[v]->getState();
+            if (state.speed != fleet.getSpeed(v) || state.batteryLevel != fleet.getBatteryLevel(v) ||
+                batteries[v]->calculateEmaRange() != fleet.getRemainingRange(v) || state.batteryTemp != fleet.getBatteryTemp(v) ||
+                speeds[v]->getTotalDistance() != fleet.getOdometer(v) || state.gasIntensity != fleet.getAcceleratorIntensity(v) ||
+                state.brakeIntensity != fleet.getBrakeIntensity(v) || batteries[v]->getBatteryKwH() != fleet.getKwH(v)) {
+                mismatches++;
+            }
+        }
+    }
+    cars.clear();
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    size_t vehicles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300;
+    const double TICK_SECONDS = 0.1;    // 10 Hz
+
+    ElectricVehicleInit::load(*VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE));
+
+    size_t mismatches = verifyAgainstSingleCar(64, 3000);
+    std::cout << "Single-car equivalence: 64 vehicles x 3000 ticks, " << mismatches << " mismatching vehicle-ticks"
+              << std::endl;
+
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t maxThreads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : hardware;
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(std::max<size_t>(1, maxThreads));
+
+    std::cout << vehicles << " vehicles, " << ticks << " ticks at " << 1.0 / TICK_SECONDS << " Hz, "
+              << hardware << " hardware threads" << std::endl;
+    std::cout << "threads  ms/tick  vehicle-steps/s  speedup  real-time x" << std::endl;
+    double baseline = 0.0;
+    for (size_t threads : threadCounts) {
+        SimulationClock clock(SimulationClock::Mode::FIXED_STEP, TICK_SECONDS);
+        ThreadPool pool(threads);
+        FleetSimulator fleet(vehicles, &clock, &pool);
+
+        double stepSeconds = 0.0;
+        for (uint64_t tick = 0; tick < ticks; tick++) {
+            // Inputs change once per simulated second, like a driver would
+            if (tick % 10 == 0) {
+                for (size_t v = 0; v < vehicles; v++) fleet.setInputs(v, driveInputs(v, tick));
+            }
+            clock.tick();
+            auto start = std::chrono::steady_clock::now();
+            fleet.step();
+            stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        double msPerTick = stepSeconds / ticks * 1000.0;
+        if (baseline == 0.0) baseline = msPerTick;
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2) << std::setw(9) << msPerTick
+                  << std::setprecision(0) << std::setw(17) << vehicles * ticks / stepSeconds << std::setprecision(2)
+                  << std::setw(9) << baseline / msPerTick << std::setprecision(1) << std::setw(13)
+                  << TICK_SECONDS * 1000.0 / msPerTick << "  (fleet energy left " << std::setprecision(0)
+                  << fleet.getTotalKwH() << " kWh)" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return mismatches == 0 ? 0 : 1;
+}
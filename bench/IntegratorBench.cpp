@@ -0,0 +1,125 @@
+// Integrates a 6-minute drive cycle with every integrator at ticks from 10 ms
+// to 1 s and compares speed and distance with a tight-tolerance RK45 run, so
+// the error of coarse ticks and the cost of each method can be read off.
+//
+//     ./IntegratorBench [tolerance]
+#include "SpeedCalculator.h"
+#include "VehicleConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const int CYCLE_SECONDS = 90;
+static const int CYCLES = 4;
+
+// Pedal levels of a second of the cycle: SPORT pull, coast, brake, full ECO pull, coast, hard stop
+static LongitudinalModel cycleModel(const LongitudinalModel& base, int second, int maxSpeedEco, int maxSpeedSport) {
+    DriveModeFactor factor;
+    LongitudinalModel model = base;
+    int phase = second % CYCLE_SECONDS;
+    model.gasLevel = phase < 25 ? 60 : (phase >= 50 && phase < 70) ? 100 : 0;
+    model.brakeLevel = (phase >= 45 && phase < 50) ? 40 : phase >= 80 ? 100 : 0;
+    model.accelerating = model.gasLevel > 0;
+    bool sport = phase < 50;
+    model.modeFactor = sport ? factor.SPORT : factor.ECO;
+    model.maxSpeed = (sport ? maxSpeedSport : maxSpeedEco) / 3.6;
+    return model;
+}
+
+struct CycleResult {
+    std::vector<double> speeds;     // km/h at every whole second
+    double distance = 0.0;          // m
+    IntegratorStats stats;
+    double nsPerSimSecond = 0.0;
+};
+
+// truncate: the original calculateSpeed, an Euler step on a speed stored as int km/h
+static CycleResult runCycle(const LongitudinalModel& base, int maxSpeedEco, int maxSpeedSport, IntegratorMethod method,
+                            int stepMs, double tolerance, bool truncate, int repeats) {
+    CycleResult result;
+    int ticks = CYCLES * CYCLE_SECONDS * 1000 / stepMs;
+    double dt = stepMs / 1000.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < repeats; repeat++) {
+        Integrator integrator(method, tolerance);
+        MotionState motion;
+        uint64_t evaluations = 0;
+        result.speeds.assign(1, 0.0);
+        for (int tick = 0; tick < ticks; tick++) {
+            LongitudinalModel model = cycleModel(base, tick * stepMs / 1000, maxSpeedEco, maxSpeedSport);
+            motion.speed = std::min(motion.speed, model.maxSpeed);
+            if (truncate) {
+                double acceleration = model(motion.speed);
+                evaluations++;
+                double speed = std::max(motion.speed + acceleration * dt, 0.0);
+                motion.position += speed * dt + 0.5 * acceleration * dt * dt;
+                motion.speed = std::min(static_cast<int>(speed * 3.6), static_cast<int>(model.maxSpeed * 3.6 + 0.5)) / 3.6;
+            } else {
+                integrator.advance(motion, dt, model);
+                motion.speed = std::min(motion.speed, model.maxSpeed);
+            }
+            if (((tick + 1) * stepMs) % 1000 == 0) {
+                result.speeds.push_back(motion.speed * 3.6);
+            }
+        }
+        result.distance = motion.position;
+        result.stats = integrator.getStats();
+        if (truncate) result.stats.evaluations = evaluations;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.nsPerSimSecond = seconds * 1e9 / repeats / (CYCLES * CYCLE_SECONDS);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    double tolerance = argc > 1 ? std::atof(argv[1]) : Integrator::DEFAULT_TOLERANCE;
+    ElectricVehicleInit::load(*VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE));
+
+    std::shared_ptr<const ProfileTables> tables = ProfileTables::current();
+    LongitudinalModel base;
+    base.tables = tables.get();
+    base.weight = ElectricVehicleInit::getDesignValue(VehicleAttribute::WEIGHT) + 200;
+    int maxSpeedEco = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_SPEED_ECO);
+    int maxSpeedSport = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_SPEED_SPORT);
+
+    CycleResult reference = runCycle(base, maxSpeedEco, maxSpeedSport, IntegratorMethod::RK45, 10, 1e-12, false, 1);
+    std::cout << "Drive cycle: " << CYCLES * CYCLE_SECONDS << " s, reference RK45 at 10 ms, tolerance 1e-12: "
+              << std::fixed << std::setprecision(1) << reference.distance << " m" << std::endl;
+    std::cout << "Integrators at tolerance " << std::scientific << std::setprecision(0) << tolerance << std::fixed
+              << ", fixed-step methods sub-stepped to " << Integrator::DEFAULT_MAX_STEP * 1000 << " ms" << std::endl;
+    std::cout << "method              tick ms  max speed err km/h  distance err m  evals/sim-s  ns/sim-s" << std::endl;
+
+    struct Row { const char* name; IntegratorMethod method; bool truncate; };
+    const Row rows[] = {
+        {"euler on int km/h", IntegratorMethod::EULER, true},
+        {"euler", IntegratorMethod::EULER, false},
+        {"semi-implicit", IntegratorMethod::SEMI_IMPLICIT_EULER, false},
+        {"rk4", IntegratorMethod::RK4, false},
+        {"rk45", IntegratorMethod::RK45, false},
+    };
+    // Ticks that divide the 5 s phases, so every tick holds one set of pedal levels
+    const int stepsMs[] = {10, 50, 250, 1000};
+    double worstRk45 = 0.0;
+    for (const Row& row : rows) {
+        for (int stepMs : stepsMs) {
+            CycleResult result = runCycle(base, maxSpeedEco, maxSpeedSport, row.method, stepMs, tolerance, row.truncate, 20);
+            double maxError = 0.0;
+            for (size_t s = 0; s < result.speeds.size() && s < reference.speeds.size(); s++) {
+                maxError = std::max(maxError, std::abs(result.speeds[s] - reference.speeds[s]));
+            }
+            if (row.method == IntegratorMethod::RK45) worstRk45 = std::max(worstRk45, maxError);
+            std::cout << std::left << std::setw(20) << row.name << std::right << std::setw(7) << stepMs
+                      << std::setw(20) << std::setprecision(6) << maxError << std::setw(16) << std::setprecision(3)
+                      << std::abs(result.distance - reference.distance) << std::setw(13) << std::setprecision(0)
+                      << result.stats.evaluations / static_cast<double>(CYCLES * CYCLE_SECONDS)
+                      << std::setw(10) << result.nsPerSimSecond << std::endl;
+        }
+    }
+    std::cout << "RK45 worst speed error over all ticks: " << std::scientific << std::setprecision(2) << worstRk45
+              << " km/h" << std::endl;
+    return 0;
+}
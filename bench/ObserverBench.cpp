@@ -0,0 +1,152 @@
+// Counts DashboardController notifications on a cruising dashboard session
+// (the highway drive cycle) and times the controller and a text-rendering
+// observer on the recorded store frames, redrawing every field on every
+// read as the observers used to against redrawing only what changed.
+//
+//     ./ObserverBench [minutes] [runs]
+#include "DashboardController.h"
+#include "DashboardSession.h"
+#include "DriveCycle.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const char* STORE_PATH = "ObserverBench.csv";
+
+// Formats one dashboard line per signal, as Display prints them
+class TextObserver : public Observer {
+public:
+    void update(const DashboardSnapshot& state, uint32_t changed) override {
+        notified++;
+        for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+            if (changed & (1u << i)) {
+                render(static_cast<SignalId>(i), state);
+                redrawn++;
+            }
+        }
+    }
+
+    std::string text() const {
+        std::string all;
+        for (const std::string& line : lines) all += line;
+        return all;
+    }
+
+    uint64_t notified = 0;
+    uint64_t redrawn = 0;
+
+private:
+    std::array<std::string, SIGNAL_COUNT> lines;
+
+    void render(SignalId id, const DashboardSnapshot& state) {
+        char line[80];
+        switch (id) {
+            case SignalId::VEHICLE_SPEED: std::snprintf(line, sizeof(line), "Speed: %u km/h\n", state.speed); break;
+            case SignalId::ROUTE_PLANNER: std::snprintf(line, sizeof(line), "Range: %u km\n", state.remainingRange); break;
+            case SignalId::BATTERY_LEVEL: std::snprintf(line, sizeof(line), "Battery: %d%%\n", state.batteryLevel); break;
+            case SignalId::AC_CONTROL:    std::snprintf(line, sizeof(line), "Climate: %d C\n", state.climateTemp); break;
+            case SignalId::WIND_LEVEL:    std::snprintf(line, sizeof(line), "Wind: %d\n", state.windLevel); break;
+            case SignalId::TURN_SIGNAL:   std::snprintf(line, sizeof(line), "Turn signal: %d\n", state.turnSignal); break;
+            case SignalId::DRIVE_MODE:
+                std::snprintf(line, sizeof(line), "Drive mode: %s\n", state.driveMode == DriveMode::Mode::SPORT ? "SPORT" : "ECO");
+                break;
+            case SignalId::BRAKE:         std::snprintf(line, sizeof(line), "Brake: %s\n", state.isBrake ? "pressed" : "released"); break;
+            case SignalId::ACCELERATOR:   std::snprintf(line, sizeof(line), "Gas: %s\n", state.isAccelerator ? "pressed" : "released"); break;
+            case SignalId::AC_STATUS:     std::snprintf(line, sizeof(line), "AC: %s\n", state.acStatus ? "ON" : "OFF"); break;
+            default: return;
+        }
+        lines[signalIndex(id)] = line;
+    }
+};
+
+// Fastest of runs, ns per frame. full: the observer redraws every field on every read
+static double replay(const std::vector<SignalFrame>& frames, int runs, bool full, TextObserver& result) {
+    double best = 0.0;
+    for (int r = 0; r < runs; r++) {
+        DashboardController controller;
+        TextObserver observer;
+        if (!full) controller.registerObserver(&observer);
+        auto start = std::chrono::steady_clock::now();
+        for (const SignalFrame& frame : frames) {
+            controller.readData(frame);
+            if (full) observer.update(controller.getSnapshot(), DASHBOARD_SIGNALS);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ns : std::min(best, ns);
+        if (!full) controller.unregisterObserver(&observer);
+        result = observer;
+    }
+    return best / frames.size();
+}
+
+int main(int argc, char* argv[]) {
+    double minutes = argc > 1 ? std::atof(argv[1]) : 30.0;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 10;
+    if (minutes <= 0.0) minutes = 30.0;
+    if (runs < 1) runs = 1;
+
+    const DriveCycle* cycle = DriveCycle::find("highway");
+    if (!cycle) {
+        std::cerr << "No highway drive cycle" << std::endl;
+        return 1;
+    }
+    std::remove(STORE_PATH);
+
+    // Drive the session and keep every frame its controller reads
+    std::vector<SignalFrame> frames;
+    TextObserver live;
+    uint64_t reads = 0, notifications = 0;
+    {
+        DashboardSession session(0, VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE), STORE_PATH);
+        if (!session.isOpen()) {
+            return 1;
+        }
+        session.getController()->registerObserver(&live);
+        uint64_t ticks = static_cast<uint64_t>(minutes * 60.0 / SimulationClock::DEFAULT_STEP);
+        uint64_t seenVersion = session.getDataHandler()->getVersion();
+        for (uint64_t t = 1; t <= ticks; t++) {
+            session.setInputs(cycle->inputsAt(t * SimulationClock::DEFAULT_STEP));
+            session.step();
+            uint64_t version = session.getDataHandler()->getVersion();
+            if (version != seenVersion) {       // the session refreshed its controller from this frame
+                seenVersion = version;
+                frames.push_back(session.getDataHandler()->readSignals());
+            }
+        }
+        reads = session.getController()->getReads();
+        notifications = session.getController()->getNotifications();
+        session.getController()->unregisterObserver(&live);
+    }
+    std::remove(STORE_PATH);
+    if (frames.empty()) {
+        std::cerr << "The session read no frames" << std::endl;
+        return 1;
+    }
+
+    TextObserver full, delta;
+    double fullNs = replay(frames, runs, true, full);
+    double deltaNs = replay(frames, runs, false, delta);
+
+    std::cout << minutes << " min of the highway cycle: " << reads << " controller reads, " << notifications
+              << " notified (" << std::fixed << std::setprecision(1) << 100.0 * notifications / reads << "%), "
+              << live.redrawn << " lines redrawn" << std::endl;
+    std::cout << "Replay of " << frames.size() << " frames, fastest of " << runs << " runs, controller + observer:"
+              << std::endl;
+    std::cout << "  every field on every read   " << std::setw(7) << fullNs << " ns per read, " << full.notified
+              << " updates, " << full.redrawn << " lines" << std::endl;
+    std::cout << "  changed fields only         " << std::setw(7) << deltaNs << " ns per read, " << delta.notified
+              << " updates, " << delta.redrawn << " lines (" << std::setprecision(1) << fullNs / deltaNs << "x)"
+              << std::endl;
+
+    if (full.text() != delta.text() || delta.notified != notifications) {
+        std::cerr << "The delta observer does not show the same dashboard" << std::endl;
+        return 1;
+    }
+    return 0;
+}
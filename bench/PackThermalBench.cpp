@@ -0,0 +1,130 @@
+// Checks the SIMD cell stencil against the scalar one, times PackThermalModel
+// per tick against its budget for several pack sizes, and prints how the
+// cell temperatures of the default pack spread under a long full-power pull.
+//
+//     ./PackThermalBench [ticks]
+#include "PackThermalModel.h"
+#include "VehicleConfig.h"
+#include "VehicleKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const double TICK_SECONDS = 0.06;
+
+// Pedal-like power trace: pulls of up to 150 kW between coasting
+static double tickPower(int tick) {
+    int phase = tick % 500;
+    return phase < 200 ? 150000.0 * phase / 200.0 : phase < 300 ? 40000.0 : 0.0;
+}
+
+static std::vector<double> cellTemps(const PackThermalModel& pack) {
+    std::vector<double> temps;
+    for (int r = 0; r < pack.getRows(); r++) {
+        for (int c = 0; c < pack.getColumns(); c++) temps.push_back(pack.getCellTemp(r, c));
+    }
+    return temps;
+}
+
+static std::vector<double> runPack(const PackThermalConfig& config, int ticks) {
+    PackThermalModel pack(config);
+    for (int t = 0; t < ticks; t++) pack.update(tickPower(t), TICK_SECONDS);
+    return cellTemps(pack);
+}
+
+static double nsPerTick(const PackThermalConfig& config, int ticks) {
+    PackThermalModel pack(config);
+    double best = 1e30;
+    for (int repeat = 0; repeat < 5; repeat++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) pack.update(tickPower(t), TICK_SECONDS);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ticks;
+        best = std::min(best, ns);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (ticks < 1) ticks = 1;
+    const KernelIsa isas[] = {KernelIsa::SCALAR, KernelIsa::SSE2, KernelIsa::AVX2};
+    KernelIsa best = VehicleKernels::detectIsa();
+    bool ok = true;
+
+    // 1. Every ISA produces the scalar cell temperatures
+    PackThermalConfig config;
+    VehicleKernels::setIsa(KernelIsa::SCALAR);
+    std::vector<double> reference = runPack(config, 2000);
+    for (KernelIsa isa : isas) {
+        VehicleKernels::setIsa(isa);
+        if (VehicleKernels::getIsa() != isa) continue;
+        std::vector<double> temps = runPack(config, 2000);
+        double worst = 0.0;
+        for (size_t i = 0; i < temps.size(); i++) {
+            worst = std::max(worst, std::abs(temps[i] - reference[i]) / std::max(std::abs(reference[i]), 1.0));
+        }
+        bool match = worst <= VehicleKernels::KERNEL_TOLERANCE;
+        ok = ok && match;
+        std::cout << std::left << std::setw(7) << VehicleKernels::isaName(isa) << std::right
+                  << " 2000 ticks of 96 cells, max relative difference to scalar " << std::scientific
+                  << std::setprecision(1) << worst << (match ? "" : "  MISMATCH") << std::endl;
+    }
+
+    // 2. Cost per tick against the budget, the lumped formula for scale
+    std::cout << std::fixed << "Per-tick cost at " << TICK_SECONDS * 1000 << " ms ticks, budget "
+              << std::setprecision(0) << PackThermalModel::TICK_BUDGET_NS << " ns for 96 cells" << std::endl;
+    std::cout << "cells   scalar ns    SSE2 ns    AVX2 ns" << std::endl;
+    const int sizes[] = {96, 384, 1536};
+    for (int cells : sizes) {
+        PackThermalConfig sized;
+        sized.cellCount = cells;
+        std::cout << std::setw(5) << cells;
+        for (KernelIsa isa : isas) {
+            VehicleKernels::setIsa(isa);
+            if (VehicleKernels::getIsa() != isa) {
+                std::cout << std::setw(11) << "-";
+                continue;
+            }
+            double ns = nsPerTick(sized, ticks * 96 / cells);
+            std::cout << std::setw(11) << std::setprecision(1) << ns;
+            if (cells == 96 && isa == best && ns > PackThermalModel::TICK_BUDGET_NS) {
+                std::cout << " OVER BUDGET";
+                ok = false;
+            }
+        }
+        std::cout << std::endl;
+    }
+    VehicleKernels::setIsa(best);
+
+    volatile double sink = 35.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) sink = VehicleCalculator::getBatteryTemp(sink, 35.0, tickPower(t));
+    std::cout << "lumped getBatteryTemp: " << std::setprecision(1)
+              << std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ticks
+              << " ns" << std::endl;
+
+    // 3. A 20-minute full-power pull, then 20 minutes parked
+    PackThermalModel pack(config);
+    double lumped = config.coolantTemp;
+    std::cout << "minute  power kW  heat W  mean C   max C  spread K  lumped C" << std::endl;
+    const int ticksPerMinute = static_cast<int>(60.0 / TICK_SECONDS + 0.5);
+    for (int minute = 1; minute <= 40; minute++) {
+        double power = minute <= 20 ? 150000.0 : 0.0;
+        for (int t = 0; t < ticksPerMinute; t++) {
+            pack.update(power, TICK_SECONDS);
+            lumped = VehicleCalculator::getBatteryTemp(lumped, config.coolantTemp, power);
+        }
+        if (minute % 5 == 0) {
+            std::cout << std::setw(6) << minute << std::setw(10) << std::setprecision(0) << power / 1000.0
+                      << std::setw(8) << pack.getHeatPower() << std::setw(8) << std::setprecision(2)
+                      << pack.getMeanTemp() << std::setw(8) << pack.getMaxTemp() << std::setw(10) << pack.getSpread()
+                      << std::setw(10) << lumped << std::endl;
+        }
+    }
+    std::cout << (ok ? "All ISAs match and the 96-cell pack is within budget" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+// Checks the shipped catalog against the built-in models, then times
+// parsing and lookups on a generated catalog, the cost of applying a new
+// profile to the components, and how long a rewritten catalog takes to
+// reach the physics loop through ProfileWatcher.
+//
+//     ./ProfileCatalogBench [models] [catalog]
+#include "BatteryManager.h"
+#include "ProfileCatalog.h"
+#include "VehicleConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* GENERATED_PATH = "ProfileCatalogBench.csv";
+static const int RUNS = 20;
+
+// Variations around the long-range model; changedModel gets changedWeight for the reload test
+static bool writeCatalog(const std::string& path, int models, int changedModel, int changedWeight) {
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary);
+    if (!file) {
+        std::cerr << "Failed to write " << temporary << std::endl;
+        return false;
+    }
+    file << "name,brand,option";
+    for (size_t a = 0; a < VEHICLE_ATTRIBUTE_COUNT; a++) file << "," << attributeName(static_cast<VehicleAttribute>(a));
+    file << "\n";
+    for (int m = 0; m < models; m++) {
+        vehicleBaseParam design = TESLA_MODEL3_LONG_RANGE;
+        design.set(VehicleAttribute::BATTERY_CAPACITY, static_cast<designValue>(50 + m % 51));
+        design.set(VehicleAttribute::MAX_TORQUE, static_cast<designValue>(300 + (m * 7) % 400));
+        design.set(VehicleAttribute::WEIGHT, static_cast<designValue>(m == changedModel ? changedWeight : 1500 + (m * 13) % 800));
+        design.set(VehicleAttribute::WHEEL_RADIUS, static_cast<designValue>(32 + m % 7));
+        char name[32];
+        std::snprintf(name, sizeof(name), "model-%05d", m);
+        file << name << ",-,-";
+        for (size_t a = 0; a < VEHICLE_ATTRIBUTE_COUNT; a++) file << "," << design[static_cast<VehicleAttribute>(a)];
+        file << "\n";
+    }
+    file.close();
+    return std::rename(temporary.c_str(), path.c_str()) == 0;     // replaced in one step, as an editor saving would
+}
+
+template <class Body>
+static double fastestNs(int runs, Body body) {
+    double best = 0.0;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int models = argc > 1 ? std::atoi(argv[1]) : 500;
+    std::string shippedPath = argc > 2 ? argv[2] : ProfileCatalog::DEFAULT_PATH;
+    if (models < 8) models = 8;
+
+    // The shipped catalog must agree with the compiled-in models
+    std::shared_ptr<const ProfileCatalog> shipped = ProfileCatalog::load(shippedPath);
+    if (!shipped) {
+        return 1;
+    }
+    const std::pair<const char*, const vehicleBaseParam*> builtIn[] = {
+        {"tesla-standard", &TESLA_MODEL3_STANDARD}, {"tesla-long-range", &TESLA_MODEL3_LONG_RANGE},
+        {"ioniq5", &HYUNDAI_IONIQ5}, {"ioniq5-performance", &HYUNDAI_IONIQ5_PERFORMANCE}};
+    for (const auto& model : builtIn) {
+        int index = shipped->find(model.first);
+        if (index < 0 || !(shipped->getDesignValues(index) == *model.second)) {
+            std::cerr << shippedPath << ": " << model.first << " differs from the built-in model" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << shippedPath << ": " << shipped->size() << " models, built-in ones match VehicleConfig.h" << std::endl;
+
+    if (!writeCatalog(GENERATED_PATH, models, -1, 0)) {
+        return 1;
+    }
+    std::shared_ptr<const ProfileCatalog> catalog;
+    double loadNs = fastestNs(RUNS, [&] { catalog = ProfileCatalog::load(GENERATED_PATH); });
+    if (!catalog || catalog->size() != static_cast<size_t>(models)) {
+        std::cerr << "Generated catalog did not load" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < catalog->size(); i++) names.emplace_back(catalog->getName(i));
+    std::shuffle(names.begin(), names.end(), std::mt19937(42));
+    long found = 0;
+    double findNs = fastestNs(RUNS, [&] {
+        for (const std::string& name : names) found += catalog->find(name) >= 0;
+    }) / names.size();
+
+    std::shared_ptr<const VehicleProfile> first, second;
+    double createNs = fastestNs(RUNS, [&] { first = catalog->createProfile(0); });
+    second = catalog->createProfile(1);
+
+    // What the physics loop does when takeUpdate() returns a profile
+    const int SWAPS = 1000;
+    double swapNs = 0.0;
+    {
+        SimulationClock clock(SimulationClock::Mode::FIXED_STEP);
+        DriveMode driveMode(*first);
+        SafetyManager safetyManager;
+        SpeedCalculator speedCalculator(&driveMode, &safetyManager, &clock, *first);
+        BatteryManager batteryManager(&speedCalculator, &clock, *first);
+        swapNs = fastestNs(RUNS, [&] {
+            for (int s = 0; s < SWAPS; s++) {
+                const VehicleProfile& profile = s % 2 ? *first : *second;
+                driveMode.setProfile(profile);
+                speedCalculator.setProfile(profile);
+                batteryManager.setProfile(profile);
+            }
+        }) / SWAPS;
+    }
+
+    std::cout << models << " generated models: parse " << std::fixed << std::setprecision(1) << loadNs / 1e6
+              << " ms (" << loadNs / models << " ns per model), " << catalog->getIndexBytes() / models
+              << " B per model, find " << findNs << " ns, createProfile with tables " << createNs / 1000.0
+              << " us, apply to the components " << swapNs << " ns" << std::endl;
+
+    // Rewrite one model and wait for it to come out of takeUpdate()
+    const int CHANGED = 7;
+    const int NEW_WEIGHT = 2222;
+    std::string watchedName(catalog->getName(CHANGED));
+    ProfileWatcher watcher(GENERATED_PATH, watchedName, catalog->createProfile(CHANGED));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));    // let the watch start
+    auto written = std::chrono::steady_clock::now();
+    if (!writeCatalog(GENERATED_PATH, models, CHANGED, NEW_WEIGHT)) {
+        return 1;
+    }
+    std::shared_ptr<const VehicleProfile> update;
+    while (!update && std::chrono::steady_clock::now() - written < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        update = watcher.takeUpdate();
+    }
+    std::remove(GENERATED_PATH);
+    if (!update || update->getDesignValue(VehicleAttribute::WEIGHT) != NEW_WEIGHT) {
+        std::cerr << "The rewritten profile did not arrive" << std::endl;
+        return 1;
+    }
+    double latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - written).count();
+    std::cout << "Hot reload: " << watchedName << " rewritten, new profile ready for the next tick after "
+              << std::setprecision(1) << latencyMs << " ms (1 ms polling), " << watcher.getReloads() << " reload"
+              << std::endl;
+    return found == static_cast<long>(RUNS) * models ? 0 : 1;
+}
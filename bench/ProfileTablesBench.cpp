@@ -0,0 +1,123 @@
+// Compares the ProfileTables lookups with the analytic VehicleCalculator
+// formulas for every built-in profile: worst-case error over the whole
+// RPM / pedal / speed range, and the cost of one tick's powertrain math.
+//
+//     ./ProfileTablesBench [ticks]
+#include "ProfileTables.h"
+#include "VehicleConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+struct Error {
+    double maxAbs = 0.0;
+    double maxRelative = 0.0;   // relative to the largest analytic value of the table
+
+    void add(double expected, double actual) { maxAbs = std::max(maxAbs, std::abs(expected - actual)); }
+    void finish(double peak) { maxRelative = peak > 0.0 ? maxAbs / peak : 0.0; }
+};
+
+static volatile double sink;
+
+int main(int argc, char* argv[]) {
+    size_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    struct Profile { VehicleOption option; VehicleBrand brand; const char* name; };
+    const Profile profiles[] = {
+        {VehicleOption::STANDAND, VehicleBrand::TESLA, "Tesla Model 3 Standard"},
+        {VehicleOption::LONG_RANGE, VehicleBrand::TESLA, "Tesla Model 3 Long Range"},
+        {VehicleOption::STANDAND, VehicleBrand::HYUNDAI, "Hyundai Ioniq 5"},
+        {VehicleOption::PERFORMANCE, VehicleBrand::HYUNDAI, "Hyundai Ioniq 5 Performance"},
+    };
+
+    std::cout << std::fixed;
+    for (const Profile& profile : profiles) {
+        ElectricVehicleInit vehicle(profile.option, profile.brand);
+        int maxRpm = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RPM);
+        int maxTorque = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_TORQUE);
+        int wheelRadius = ElectricVehicleInit::getDesignValue(VehicleAttribute::WHEEL_RADIUS);
+        auto tables = ProfileTables::current();
+
+        // Accuracy: every integer RPM and pedal level, speeds every 1 mm/s
+        Error torque, traction, power, speedTraction;
+        double peakTorque = 0.0, peakTraction = 0.0, peakPower = 0.0;
+        for (int rpm = 0; rpm <= maxRpm; rpm++) {
+            for (int gas = 0; gas <= 100; gas++) {
+                double expected = VehicleCalculator::getTorque(rpm, maxRpm, gas, maxTorque);
+                double expectedTraction = VehicleCalculator::getTractiveForce(wheelRadius, expected);
+                torque.add(expected, tables->torque(rpm, gas));
+                traction.add(expectedTraction, tables->tractiveForce(rpm, gas));
+                peakTorque = std::max(peakTorque, expected);
+                peakTraction = std::max(peakTraction, expectedTraction);
+            }
+        }
+        double topSpeed = 0.0;
+        while (VehicleCalculator::getRpm(topSpeed, wheelRadius, maxRpm) < maxRpm) topSpeed += 1.0;
+        for (double speed = 0.0; speed <= topSpeed + 5.0; speed += 0.001) {
+            int rpm = VehicleCalculator::getRpm(speed, wheelRadius, maxRpm);
+            for (int gas : {1, 25, 50, 100}) {
+                double expected = VehicleCalculator::getPowerEngine(VehicleCalculator::getTorque(rpm, maxRpm, gas, maxTorque),
+                                                                    VehicleCalculator::getAngularSpeed(rpm));
+                double expectedTraction = VehicleCalculator::getTractiveForce(
+                    wheelRadius, VehicleCalculator::getTorque(rpm, maxRpm, gas, maxTorque));
+                double tractionAtSpeed, powerAtSpeed;
+                tables->atSpeed(speed, gas, tractionAtSpeed, powerAtSpeed);
+                power.add(expected, powerAtSpeed);
+                speedTraction.add(expectedTraction, tractionAtSpeed);
+                peakPower = std::max(peakPower, expected);
+            }
+        }
+        torque.finish(peakTorque);
+        traction.finish(peakTraction);
+        power.finish(peakPower);
+        speedTraction.finish(peakTraction);
+
+        // Per-tick cost of traction and power on varied speeds and pedal levels
+        std::vector<double> speeds(4096);
+        std::vector<int> gases(4096);
+        for (size_t i = 0; i < speeds.size(); i++) {
+            speeds[i] = std::fmod(i * 0.7919, topSpeed + 2.0);
+            gases[i] = static_cast<int>((i * 37) % 101);
+        }
+        auto analytic = [&](size_t i) {
+            int rpm = VehicleCalculator::getRpm(speeds[i], wheelRadius, maxRpm);
+            double t = VehicleCalculator::getTorque(rpm, maxRpm, gases[i], maxTorque);
+            double p = VehicleCalculator::getPowerEngine(t, VehicleCalculator::getAngularSpeed(rpm));
+            return p + VehicleCalculator::getTractiveForce(wheelRadius, t);
+        };
+        auto lookup = [&](size_t i) {
+            double t, p;
+            tables->atSpeed(speeds[i], gases[i], t, p);
+            return p + t;
+        };
+        auto time = [&](auto&& tick) {
+            double best = 1e9;
+            for (int run = 0; run < 5; run++) {
+                double sum = 0.0;
+                auto start = std::chrono::steady_clock::now();
+                for (size_t n = 0; n < ticks; n++) sum += tick(n & 4095);
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                sink = sum;
+                best = std::min(best, ns / ticks);
+            }
+            return best;
+        };
+        double analyticNs = time(analytic);
+        double lookupNs = time(lookup);
+
+        std::cout << profile.name << " (" << maxRpm << " RPM, " << maxTorque << " Nm, " << tables->getTableBytes()
+                  << " table bytes)" << std::endl;
+        std::cout << std::scientific << std::setprecision(2)
+                  << "  torque(rpm) max error " << torque.maxAbs << " Nm (" << torque.maxRelative << " of peak)" << std::endl
+                  << "  tractiveForce(rpm) max error " << traction.maxAbs << " N (" << traction.maxRelative << " of peak)" << std::endl
+                  << "  atSpeed traction max error " << speedTraction.maxAbs << " N (" << speedTraction.maxRelative
+                  << " of peak)" << std::endl
+                  << "  atSpeed power max error " << power.maxAbs << " W (" << power.maxRelative << " of peak)" << std::endl;
+        std::cout << std::fixed << std::setprecision(2) << "  per tick: analytic " << analyticNs << " ns, tables "
+                  << lookupNs << " ns (" << analyticNs / lookupNs << "x)" << std::endl;
+    }
+    return 0;
+}
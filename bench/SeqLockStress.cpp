@@ -0,0 +1,124 @@
+// Stress test for SeqLock: one writer publishes VehicleState values whose
+// every field is derived from one counter, while reader threads check each
+// snapshot they load against that counter. Exits 1 on any torn read.
+//
+//     ./SeqLockStress [readers] [seconds]
+#include "VehicleState.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static VehicleState stateFor(uint64_t counter) {
+    VehicleState state;
+    state.tick = counter;
+    state.inputs.driveMode = (counter & 1) ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    state.inputs.acStatus = counter & 2;
+    state.inputs.isAccelerator = counter & 4;
+    state.inputs.isBrake = counter & 8;
+    state.inputs.acTemp = static_cast<int>(counter % 32);
+    state.inputs.windLevel = static_cast<int>(counter % 7);
+    state.inputs.turnSignal = static_cast<int>(counter % 3);
+    state.speed = static_cast<int>(counter % 100000) * 3;
+    state.outputPower = static_cast<int>(counter % 100000) * 5;
+    state.batteryLevel = counter * 0.25;
+    state.remainingRange = counter * 0.5;
+    state.rangeP10 = counter * 0.375;
+    state.rangeP50 = counter * 0.5;
+    state.rangeP90 = counter * 0.625;
+    state.batteryTemp = counter * 0.125;
+    state.odometer = counter * 2.0;
+    state.isSafetyAction = counter & 16;
+    state.gasIntensity = static_cast<int>(counter % 101);
+    state.brakeIntensity = static_cast<int>((counter * 7) % 101);
+    return state;
+}
+
+static bool isConsistent(const VehicleState& state) {
+    const VehicleState expected = stateFor(state.tick);
+    const DriverInputs& a = state.inputs;
+    const DriverInputs& b = expected.inputs;
+    return state.rangeP10 == expected.rangeP10 && state.rangeP50 == expected.rangeP50 &&
+           state.rangeP90 == expected.rangeP90 && a.driveMode == b.driveMode && a.acStatus == b.acStatus && a.isAccelerator == b.isAccelerator &&
+           a.isBrake == b.isBrake && a.acTemp == b.acTemp && a.windLevel == b.windLevel &&
+           a.turnSignal == b.turnSignal && state.speed == expected.speed && state.outputPower == expected.outputPower &&
+           state.batteryLevel == expected.batteryLevel && state.remainingRange == expected.remainingRange &&
+           state.batteryTemp == expected.batteryTemp && state.odometer == expected.odometer &&
+           state.isSafetyAction == expected.isSafetyAction && state.gasIntensity == expected.gasIntensity &&
+           state.brakeIntensity == expected.brakeIntensity;
+}
+
+struct ReaderResult {
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t backwards = 0;     // a snapshot older than the previous one
+    uint64_t distinct = 0;      // snapshots that differed from the previous one
+};
+
+int main(int argc, char* argv[]) {
+    int readers = argc > 1 ? std::atoi(argv[1]) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    if (readers < 1) readers = 1;
+    if (seconds <= 0.0) seconds = 2.0;
+
+    // The check must catch a snapshot mixing two stores
+    VehicleState mixed = stateFor(41);
+    mixed.odometer = stateFor(42).odometer;
+    if (isConsistent(mixed)) {
+        std::cerr << "The consistency check misses a mixed snapshot" << std::endl;
+        return 1;
+    }
+    if (std::thread::hardware_concurrency() < 2) {
+        std::cout << "Only one hardware thread: readers overlap the writer only when preempted" << std::endl;
+    }
+
+    VehicleStateChannel channel;
+    channel.store(stateFor(0));
+    std::atomic<bool> running(true);
+    std::vector<ReaderResult> results(readers);
+    std::vector<std::thread> threads;
+
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            ReaderResult& result = results[r];
+            uint64_t previous = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                VehicleState state = channel.load();
+                result.reads++;
+                if (!isConsistent(state)) {
+                    result.torn++;
+                    continue;
+                }
+                if (state.tick < previous) result.backwards++;
+                if (state.tick != previous) result.distinct++;
+                previous = state.tick;
+            }
+        });
+    }
+
+    uint64_t stores = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1024; i++) channel.store(stateFor(++stores));
+    }
+    running = false;
+    for (auto& thread : threads) thread.join();
+
+    ReaderResult total;
+    for (const ReaderResult& result : results) {
+        total.reads += result.reads;
+        total.torn += result.torn;
+        total.backwards += result.backwards;
+        total.distinct += result.distinct;
+    }
+    std::cout << readers << " readers, " << seconds << " s: " << stores << " stores, " << total.reads
+              << " reads (" << total.distinct << " saw a new value), " << total.torn << " torn, " << total.backwards
+              << " out of order" << std::endl;
+    if (total.torn != 0 || total.backwards != 0) {
+        std::cerr << "SeqLock returned an inconsistent snapshot" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Hosts many dashboard sessions in one process and reports the memory and
+// threads each one costs, the session ticks per second across 1..N worker
+// threads, and whether the 60 ms dashboard tick holds in real time.
+//
+//     ./SessionHostBench [sessions] [ticks] [max threads]
+#include "SessionHost.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const std::string STORE_DIR = "SessionHostBench.d";
+
+// Each station drives the 60 s accelerate / coast / brake cycle with its own offset and settings
+static DriverInputs stationInputs(int session, uint64_t tick) {
+    uint64_t cycleTick = (tick + session * 37) % 1000;
+    DriverInputs inputs;
+    inputs.isAccelerator = cycleTick < 500;
+    inputs.isBrake = cycleTick >= 800 && cycleTick < 900;
+    inputs.driveMode = ((tick / 2000 + session) % 3 == 0) ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    inputs.acStatus = true;
+    inputs.acTemp = 18 + session % 8;
+    inputs.windLevel = session % 6;
+    return inputs;
+}
+
+static std::string storePath(int session) {
+    return STORE_DIR + "/session" + std::to_string(session) + ".csv";
+}
+
+static long residentKb() {
+    long pages = 0, resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> pages >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static int threadCount() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) return std::atoi(line.c_str() + 8);
+    }
+    return 0;
+}
+
+static void addSessions(SessionHost& host, const std::vector<std::shared_ptr<const VehicleProfile>>& profiles, int count) {
+    for (int id = 0; id < count; id++) {
+        host.addSession(std::make_unique<DashboardSession>(id, profiles[id % profiles.size()], storePath(id)));
+    }
+}
+
+// A session against the same components driven directly, bit for bit
+static bool matchesStandalone(const DashboardSession& session, uint64_t ticks) {
+    const VehicleProfile& profile = session.getProfile();
+    SimulationClock clock(SimulationClock::Mode::FIXED_STEP);
+    SafetyManager safetyManager;
+    DriveMode driveMode(profile);
+    SpeedCalculator speedCalculator(&driveMode, &safetyManager, &clock, profile);
+    BatteryManager batteryManager(&speedCalculator, &clock, profile);
+    DriverInputs initial;
+    initial.acStatus = true;
+    initial.acTemp = 22;
+    initial.windLevel = 2;
+    VehicleSimulation simulation(&driveMode, &safetyManager, &speedCalculator, &batteryManager, initial);
+    for (uint64_t tick = 0; tick < ticks; tick++) {
+        clock.tick();
+        simulation.step(stationInputs(session.getId(), tick));
+    }
+    VehicleState expected = simulation.getState();
+    VehicleState actual = session.getState();
+    return expected.tick == actual.tick && expected.speed == actual.speed &&
+           expected.batteryLevel == actual.batteryLevel && expected.batteryTemp == actual.batteryTemp &&
+           expected.remainingRange == actual.remainingRange &&
+           speedCalculator.getTotalDistance() == session.getTotalDistance() &&
+           batteryManager.getBatteryKwH() == session.getBatteryKwH();
+}
+
+static void removeStores(int count) {
+    for (int id = 0; id < count; id++) {
+        std::remove(storePath(id).c_str());
+    }
+    rmdir(STORE_DIR.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    int sessions = argc > 1 ? std::atoi(argv[1]) : 500;
+    uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    size_t maxThreads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    const double TICK_MS = SimulationClock::DEFAULT_STEP * 1000.0;
+    if (sessions < 1 || ticks < 1) {
+        std::cerr << "Usage: " << argv[0] << " [sessions] [ticks] [max threads]" << std::endl;
+        return 1;
+    }
+    mkdir(STORE_DIR.c_str(), 0755);
+
+    std::vector<std::shared_ptr<const VehicleProfile>> profiles = {
+        VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::STANDAND),
+        VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE),
+        VehicleProfile::create(VehicleBrand::HYUNDAI, VehicleOption::STANDAND),
+        VehicleProfile::create(VehicleBrand::HYUNDAI, VehicleOption::PERFORMANCE)
+    };
+    std::cout << sessions << " sessions of " << profiles.size() << " profiles, " << ticks << " ticks of "
+              << TICK_MS << " ms" << std::endl;
+
+    // 1. Session ticks per second across worker counts, as fast as the host can step
+    bool matches = true;
+    double baseline = 0.0;
+    std::cout << "threads  ms/tick  session ticks/s  sessions per tick budget  speedup" << std::endl;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads);
+        std::unique_ptr<SessionHost> host(new SessionHost(&pool));
+        long rssBefore = residentKb();
+        int threadsBefore = threadCount();
+        addSessions(*host, profiles, sessions);
+        if (static_cast<int>(host->getSessionCount()) != sessions) {
+            std::cerr << "Only " << host->getSessionCount() << " sessions opened" << std::endl;
+            return 1;
+        }
+        int threadsAfter = threadCount();
+        if (threadsAfter != threadsBefore) {
+            std::cerr << "Adding sessions started " << threadsAfter - threadsBefore << " threads" << std::endl;
+            return 1;
+        }
+
+        double tickSeconds = 0.0;
+        for (uint64_t tick = 0; tick < ticks; tick++) {
+            for (int id = 0; id < sessions; id++) {
+                host->getSession(id)->setInputs(stationInputs(id, tick));
+            }
+            auto start = std::chrono::steady_clock::now();
+            host->tick();
+            tickSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        long rssAfter = residentKb();
+
+        double rate = static_cast<double>(ticks) * sessions / tickSeconds;
+        if (threads == 1) baseline = rate;
+        std::cout << std::fixed << std::setw(7) << threads << std::setw(9) << std::setprecision(3)
+                  << tickSeconds * 1000.0 / ticks << std::setw(17) << std::setprecision(0) << rate
+                  << std::setw(26) << rate * TICK_MS / 1000.0 << std::setw(9) << std::setprecision(2)
+                  << rate / baseline << "x" << std::endl;
+
+        if (threads == 1) {
+            for (int id = 0; id < static_cast<int>(profiles.size()) && id < sessions; id++) {
+                matches = matchesStandalone(*host->getSession(id), ticks) && matches;
+            }
+        }
+        host.reset();
+        if (threads == 1) {
+            std::cout << "  memory: " << std::setprecision(1) << static_cast<double>(rssAfter - rssBefore) / sessions
+                      << " KB resident per session, threads " << threadsBefore << " -> " << threadsAfter << std::endl;
+            std::cout << "  one session per profile against its components driven directly: "
+                      << (matches ? "identical" : "MISMATCH") << std::endl;
+        }
+    }
+
+    // 2. Real time: every session ticks every 60 ms on all worker threads
+    {
+        ThreadPool pool(maxThreads);
+        SessionHost host(&pool);
+        addSessions(host, profiles, sessions);
+        std::atomic<bool> running(true);
+        std::thread stopper([&running]() {
+            std::this_thread::sleep_for(std::chrono::seconds(3));
+            running = false;
+        });
+        host.run(std::chrono::milliseconds(static_cast<int>(TICK_MS)), running);
+        stopper.join();
+        std::cout << "Real time on " << maxThreads << " threads: " << host.getTicks() << " ticks in 3 s, "
+                  << host.getSessionTicks() << " session ticks, " << host.getOverruns() << " overruns" << std::endl;
+    }
+
+    removeStores(sessions);
+    return matches ? 0 : 1;
+}
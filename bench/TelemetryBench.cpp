@@ -0,0 +1,124 @@
+// Measures the cost of TelemetryRecorder::record() on the producer, the sustained
+// write throughput and the compression ratio on a synthetic drive.
+//
+//     ./TelemetryBench [samples]
+#include "TelemetryRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Deterministic drive: repeated accelerate / cruise / brake cycles sampled every 10 ms
+static TelemetrySample driveSample(size_t i) {
+    static const int64_t START = 1700000000000000LL;
+    TelemetrySample sample;
+    sample.timestampMicros = START + static_cast<int64_t>(i) * 10000 + static_cast<int64_t>((i * 7919) % 150);
+
+    size_t phase = (i / 1500) % 4;     // 15 s per phase
+    double progress = (i % 1500) / 1500.0;
+    double speed = phase == 0 ? 120.0 * progress : phase == 3 ? 120.0 * (1.0 - progress) : 120.0;
+    DriverInputs inputs;
+    inputs.isAccelerator = phase == 0;
+    inputs.isBrake = phase == 3;
+    inputs.driveMode = (i / 60000) % 2 ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    inputs.acStatus = true;
+    inputs.acTemp = 22;
+    inputs.windLevel = 2;
+
+    sample.speed = static_cast<int>(speed);
+    sample.gasIntensity = inputs.isAccelerator ? 20 : 0;
+    sample.brakeIntensity = inputs.isBrake ? 20 : 0;
+    sample.inputFlags = packInputFlags(inputs);
+    sample.acTemp = inputs.acTemp;
+    sample.windLevel = inputs.windLevel;
+    double metersPerSecond = sample.speed / 3.6;
+    sample.powerConsumption = 0.5 * 1.225 * 0.23 * 2.22 * std::pow(metersPerSecond, 3) + 0.01 * 1800 * 9.81 * metersPerSecond;
+    sample.currentKwH = 75.0 - i * 0.00004;
+    sample.batteryTemp = 35.0 + 5.0 * (1.0 - std::exp(-static_cast<double>(i) / 100000.0));
+    sample.odometer = i * 0.0002;
+    return sample;
+}
+
+static void removeLog(const std::string& path) {
+    std::remove(path.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const std::string path = "TelemetryBench.telemetry";
+
+    // 1. Producer overhead at a 10 kHz tick, 600x the dashboard's 60 ms loop
+    {
+        TelemetryRecorder recorder(path);
+        const size_t paced = 50000;
+        std::vector<double> costNs(paced);
+        auto next = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < paced; i++) {
+            next += std::chrono::microseconds(100);
+            while (std::chrono::steady_clock::now() < next) {
+            }
+            TelemetrySample sample = driveSample(i);
+            auto start = std::chrono::steady_clock::now();
+            recorder.record(sample);
+            costNs[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+        recorder.close();
+
+        // Percentiles, so a preempted call does not hide the common case
+        std::sort(costNs.begin(), costNs.end());
+        TelemetryStats stats = recorder.getStats();
+        std::cout << "record() at 10 kHz: " << paced << " samples, p50 " << std::fixed << std::setprecision(1)
+                  << costNs[paced / 2] << " ns, p99 " << costNs[paced * 99 / 100] << " ns, max "
+                  << costNs.back() / 1000.0 << " us (two clock reads included), " << stats.samplesDropped
+                  << " dropped" << std::endl;
+        removeLog(path);
+    }
+
+    // 2. Sustained throughput: push as fast as the writer accepts
+    TelemetryStats stats;
+    double elapsedS;
+    uint64_t retries = 0;
+    {
+        TelemetryRecorder recorder(path);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < samples; i++) {
+            TelemetrySample sample = driveSample(i);
+            while (!recorder.record(sample)) {
+                retries++;
+            }
+        }
+        recorder.close();
+        elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats = recorder.getStats();
+    }
+    std::cout << "Throughput: " << stats.samplesWritten << " samples in " << std::setprecision(3) << elapsedS << " s = "
+              << stats.samplesWritten / elapsedS / 1e6 << " M samples/s, "
+              << stats.rawBytes / elapsedS / 1e6 << " MB/s raw, " << stats.encodedBytes / elapsedS / 1e6
+              << " MB/s written (" << retries << " full-queue retries)" << std::endl;
+    std::cout << "Writer: encode " << stats.encodeMs << " ms, write " << stats.writeMs << " ms, "
+              << stats.blocksWritten << " blocks" << std::endl;
+    std::cout << "Size: " << stats.rawBytes << " raw bytes -> " << stats.encodedBytes << " bytes, ratio "
+              << std::setprecision(2) << stats.compressionRatio() << "x, "
+              << static_cast<double>(stats.encodedBytes) / stats.samplesWritten << " bytes/sample" << std::endl;
+
+    // 3. Read back and verify every field bit for bit
+    TelemetryReader reader(path);
+    std::vector<TelemetrySample> decoded;
+    auto readStart = std::chrono::steady_clock::now();
+    reader.readAll(decoded);
+    double readS = std::chrono::duration<double>(std::chrono::steady_clock::now() - readStart).count();
+    size_t mismatches = decoded.size() == samples ? 0 : 1;
+    for (size_t i = 0; i < decoded.size() && i < samples; i++) {
+        TelemetrySample expected = driveSample(i);
+        if (std::memcmp(&expected, &decoded[i], sizeof(expected)) != 0) mismatches++;
+    }
+    std::cout << "Read back " << decoded.size() << " samples in " << std::setprecision(3) << readS << " s, "
+              << mismatches << " mismatches" << std::endl;
+    removeLog(path);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// Times every VehicleKernels batch kernel with the scalar, SSE2 and AVX2
+// implementations and checks the SIMD results against the scalar ones.
+//
+//     ./VehicleKernelsBench [elements] [repeats]
+#include "VehicleConfig.h"
+#include "VehicleKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+static const int KERNEL_COUNT = 7;
+static const char* KERNEL_NAMES[KERNEL_COUNT] = {
+    "rpm", "torque", "tractiveForce", "enginePower", "airDragForce", "acceleration", "batteryTemp"
+};
+
+struct Inputs {
+    std::vector<double> speed;
+    std::vector<int32_t> gas;
+    std::vector<int32_t> brake;
+    std::vector<double> lastAcceleration;
+    std::vector<double> batteryTemp;
+};
+
+struct Outputs {
+    std::vector<double> rpm, torque, traction, power, drag, acceleration, lastAcceleration, batteryTemp;
+    double seconds[KERNEL_COUNT] = {};
+};
+
+// Mix of standstill, crawling and cruising vehicles so every mask path is taken
+static Inputs makeInputs(size_t count) {
+    Inputs in;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    for (size_t i = 0; i < count; i++) {
+        double r = next();
+        in.speed.push_back(r < 0.05 ? 0.0 : r < 0.10 ? 0.005 * next() : 70.0 * next());
+        in.gas.push_back(next() < 0.1 ? 0 : static_cast<int32_t>(100 * next()));
+        in.brake.push_back(next() < 0.7 ? 0 : static_cast<int32_t>(100 * next()));
+        in.lastAcceleration.push_back(-1.0 + 4.0 * next());
+        in.batteryTemp.push_back(20.0 + 30.0 * next());
+    }
+    return in;
+}
+
+static Outputs run(const Inputs& in, int repeats, int wheelRadius, int maxRpm, int maxTorque, int weight) {
+    size_t n = in.speed.size();
+    Outputs out;
+    out.rpm.resize(n); out.torque.resize(n); out.traction.resize(n); out.power.resize(n);
+    out.drag.resize(n); out.acceleration.resize(n);
+    for (int k = 0; k < KERNEL_COUNT; k++) out.seconds[k] = 1e9;
+
+    for (int r = 0; r < repeats; r++) {
+        out.lastAcceleration = in.lastAcceleration;
+        out.batteryTemp = in.batteryTemp;
+        double elapsed[KERNEL_COUNT];
+        auto time = [](auto&& kernel) {
+            auto start = std::chrono::steady_clock::now();
+            kernel();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        elapsed[0] = time([&] { VehicleKernels::rpm(in.speed.data(), n, wheelRadius, maxRpm, out.rpm.data()); });
+        elapsed[1] = time([&] {
+            VehicleKernels::torque(out.rpm.data(), in.gas.data(), n, maxRpm, maxTorque, out.torque.data());
+        });
+        elapsed[2] = time([&] { VehicleKernels::tractiveForce(out.torque.data(), n, wheelRadius, out.traction.data()); });
+        elapsed[3] = time([&] { VehicleKernels::enginePower(out.torque.data(), out.rpm.data(), n, out.power.data()); });
+        elapsed[4] = time([&] { VehicleKernels::airDragForce(in.speed.data(), n, out.drag.data()); });
+        elapsed[5] = time([&] {
+            VehicleKernels::acceleration(in.speed.data(), out.traction.data(), in.brake.data(), n, weight,
+                                         out.lastAcceleration.data(), out.acceleration.data());
+        });
+        elapsed[6] = time([&] { VehicleKernels::batteryTemp(out.batteryTemp.data(), out.power.data(), n, 35.0); });
+        for (int k = 0; k < KERNEL_COUNT; k++) out.seconds[k] = std::min(out.seconds[k], elapsed[k]);
+    }
+    return out;
+}
+
+static double maxRelativeError(const std::vector<double>& reference, const std::vector<double>& actual) {
+    double worst = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        double scale = std::max(std::abs(reference[i]), 1e-300);
+        if (reference[i] == actual[i]) continue;
+        worst = std::max(worst, std::abs(reference[i] - actual[i]) / scale);
+    }
+    return worst;
+}
+
+int main(int argc, char* argv[]) {
+    size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    ElectricVehicleInit vehicle(VehicleOption::LONG_RANGE, VehicleBrand::TESLA);
+    int wheelRadius = ElectricVehicleInit::getDesignValue(VehicleAttribute::WHEEL_RADIUS);
+    int maxRpm = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RPM);
+    int maxTorque = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_TORQUE);
+    int weight = ElectricVehicleInit::getDesignValue(VehicleAttribute::WEIGHT) + 200;
+
+    Inputs in = makeInputs(elements);
+    KernelIsa best = VehicleKernels::detectIsa();
+    std::cout << elements << " elements, best of " << repeats << " runs, CPU supports "
+              << VehicleKernels::isaName(best) << std::endl;
+
+    std::vector<KernelIsa> isas = {KernelIsa::SCALAR};
+    if (best != KernelIsa::SCALAR) isas.push_back(KernelIsa::SSE2);
+    if (best == KernelIsa::AVX2) isas.push_back(KernelIsa::AVX2);
+
+    std::vector<Outputs> results;
+    for (KernelIsa isa : isas) {
+        VehicleKernels::setIsa(isa);
+        results.push_back(run(in, repeats, wheelRadius, maxRpm, maxTorque, weight));
+    }
+    VehicleKernels::setIsa(best);
+
+    std::cout << std::left << std::setw(15) << "kernel";
+    for (KernelIsa isa : isas) std::cout << std::right << std::setw(10) << VehicleKernels::isaName(isa) << " ns/elem";
+    for (size_t j = 1; j < isas.size(); j++) std::cout << std::setw(10) << VehicleKernels::isaName(isas[j]) << " x";
+    std::cout << std::endl;
+
+    double totals[3] = {};
+    for (int k = 0; k <= KERNEL_COUNT; k++) {
+        bool total = k == KERNEL_COUNT;
+        std::cout << std::left << std::setw(15) << (total ? "pipeline" : KERNEL_NAMES[k]) << std::right << std::fixed;
+        for (size_t j = 0; j < isas.size(); j++) {
+            double seconds = total ? totals[j] : results[j].seconds[k];
+            if (!total) totals[j] += seconds;
+            std::cout << std::setprecision(3) << std::setw(18) << seconds / elements * 1e9;
+        }
+        for (size_t j = 1; j < isas.size(); j++) {
+            double base = total ? totals[0] : results[0].seconds[k];
+            double seconds = total ? totals[j] : results[j].seconds[k];
+            std::cout << std::setprecision(2) << std::setw(11) << base / seconds << "x";
+        }
+        std::cout << std::endl;
+    }
+
+    bool withinTolerance = true;
+    for (size_t j = 1; j < isas.size(); j++) {
+        const Outputs& ref = results[0];
+        const Outputs& simd = results[j];
+        double errors[KERNEL_COUNT] = {
+            maxRelativeError(ref.rpm, simd.rpm), maxRelativeError(ref.torque, simd.torque),
+            maxRelativeError(ref.traction, simd.traction), maxRelativeError(ref.power, simd.power),
+            maxRelativeError(ref.drag, simd.drag),
+            std::max(maxRelativeError(ref.acceleration, simd.acceleration),
+                     maxRelativeError(ref.lastAcceleration, simd.lastAcceleration)),
+            maxRelativeError(ref.batteryTemp, simd.batteryTemp)
+        };
+        double worst = *std::max_element(errors, errors + KERNEL_COUNT);
+        withinTolerance = withinTolerance && worst <= VehicleKernels::KERNEL_TOLERANCE;
+        std::cout << VehicleKernels::isaName(isas[j]) << " vs scalar: max relative error " << std::scientific
+                  << std::setprecision(2) << worst << " (tolerance " << VehicleKernels::KERNEL_TOLERANCE << ")"
+                  << std::endl;
+    }
+    return withinTolerance ? 0 : 1;
+}
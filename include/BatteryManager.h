@@ -2,35 +2,90 @@
 #define BATTERY_MANAGER_H
 
 #include "SpeedCalculator.h"
+#include "SimulationClock.h"
+#include "RangePredictor.h"
+#include "PackThermalModel.h"
+#include "MonteCarloRange.h"
+#include "ThreadPool.h"
+#include <memory>
+
+enum class RangeModel {
+    EMA,            // remaining kWh over a moving average of the lifetime kWh/km
+    ENERGY_MAP      // RangePredictor at the current auxiliary load
+};
 
 /**
  * @brief BatteryManager class
  * 
  * This class manages the battery of the car.
  * It calculates the remaining range, battery temperature, and updates the battery capacity.
+ * The range comes from the RangePredictor energy map unless the EMA model is selected.
+ * With a pack model enabled, the battery temperature is that of the hottest cell.
+ * With a range distribution enabled, a MonteCarloRange watches the driving
+ * every tick and starts re-simulating a slice of its samples on the
+ * ThreadPool once per RANGE_REFRESH_SECONDS of simulated time, giving
+ * P10/P50/P90 range. The slice runs in the background; the update never
+ * waits for it.
  */
 class BatteryManager {
 public:
-    BatteryManager(SpeedCalculator* speedCalculator);
+    static constexpr double ENVIRONMENT_TEMP = 35.0;       // C, ambient air and the battery at rest
+    static constexpr double RANGE_REFRESH_SECONDS = 1.0;
+    static constexpr size_t RANGE_REFRESH_SHARE = 64;      // samples re-simulated per refresh: 1 / RANGE_REFRESH_SHARE
+
+    BatteryManager(SpeedCalculator* speedCalculator, SimulationClock* clock);  // the ElectricVehicleInit profile
+    BatteryManager(SpeedCalculator* speedCalculator, SimulationClock* clock, const VehicleProfile& profile);
     ~BatteryManager();
 
     double calculateRemainingRange();
+    double calculateEmaRange() const;   // the EMA estimate, whichever model is selected
     double calculateBatteryTemp();
-    void updateBatteryCapacity(int acTemp, int windLevel);
+    void updateBatteryCapacity(int acTemp, int windLevel);  // drain for the clock's current tick
+    void restoreBatteryLevel(double batteryLevel); // resume the charge (%) after a restart
+    void setProfile(const VehicleProfile& profile);  // another pack and range, charge (%) kept; the energy map restarts
     
     double getBatteryCapacity() const {return batteryCapacity;}
+    double getBatteryKwH() const {return currentKwH;}
+
+    void setRangeModel(RangeModel model) { rangeModel = model; }
+    RangeModel getRangeModel() const { return rangeModel; }
+    const RangePredictor& getRangePredictor() const { return rangePredictor; }
+    double getAuxPower() const { return auxPower; }
+
+    void enablePackModel(const PackThermalConfig& config = PackThermalConfig());   // per-cell temperatures from now on
+    const PackThermalModel* getPackModel() const { return packModel.get(); }        // nullptr for the lumped model
+    double getMaxCellTemp() const { return packModel ? packModel->getMaxTemp() : batteryTemp; }
+    double getCellTempSpread() const { return packModel ? packModel->getSpread() : 0.0; }
+
+    void enableRangeDistribution(ThreadPool* pool, size_t samples = MonteCarloRange::DEFAULT_SAMPLES);
+    void updateRangeDistribution(const DriverInputs& inputs);  // every tick, after the speed
+    RangePercentiles getRangePercentiles() const;               // samples == 0 while disabled or before the first slice
 
 private:
     SpeedCalculator* speedCalculator;
+    SimulationClock* clock;
+    VehicleProfile profile;
 
     double batteryCapacity;
     double batteryMaxCapacity;  // kWh
     double drainPerKm; // consumption capacity per km
     double currentKwH; // current battery capacity in kWh
     double batteryTemp;
+    int maxRange;
+    int maxAcPower;
+
+    // Per-vehicle history between updates
+    double previousDrainPerKm;
+    RangeModel rangeModel;
+    RangePredictor rangePredictor;
+    double auxPower;            // W, AC and fan during the last update
+    double observedDistance;    // km, odometer at the last update; negative before the first
+    std::unique_ptr<PackThermalModel> packModel;
+    std::unique_ptr<MonteCarloRange> rangeDistribution;
+    ThreadPool* rangePool;
+    double sinceRangeRefresh;   // s of simulated time
 
     double calculateDrainPerKm(int acTemp, int windLevel) const;
-    double getBatteryKwH() const {return currentKwH;}
 };
 
 #endif // BATTERY_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,10 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3), used to detect torn or corrupt records on disk
+uint32_t crc32(const uint8_t* data, size_t length);
+
+#endif // CRC32_H
@@ -0,0 +1,62 @@
+#ifndef CSV_CODEC_H
+#define CSV_CODEC_H
+
+#include <string>
+#include <string_view>
+#include "SignalRegistry.h"
+
+constexpr std::string_view CSV_HEADER = "key,value";
+
+// Read the whole file into buffer, reusing its capacity
+bool readFile(const std::string& path, std::string& buffer);
+
+/**
+ * Call onRow(key, value) for every "key,value" line after the header.
+ * The views point into text, so nothing is copied or allocated. Lines
+ * without a comma are skipped; a trailing '\r' is dropped.
+ */
+template <typename RowHandler>
+size_t parseCsv(std::string_view text, RowHandler&& onRow) {
+    size_t rows = 0;
+    bool header = true;
+    while (!text.empty()) {
+        size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (header) {
+            header = false;
+            continue;
+        }
+        size_t comma = line.find(',');
+        if (comma == std::string_view::npos) {
+            continue;
+        }
+        onRow(line.substr(0, comma), line.substr(comma + 1));
+        rows++;
+    }
+    return rows;
+}
+
+/**
+ * @brief CsvWriter class
+ *
+ * Serializes "key,value" rows into one reusable buffer and writes the
+ * whole file with a single write() call. Numbers are formatted with
+ * std::to_chars, so a warm writer does not allocate.
+ */
+class CsvWriter {
+public:
+    void begin();                                       // clear the buffer and add the header
+    void appendRow(std::string_view key, std::string_view value);
+    void appendSignal(SignalId id, double value);
+    std::string_view view() const { return buffer; }
+    bool writeFile(const std::string& path) const;
+
+private:
+    std::string buffer;
+};
+
+#endif // CSV_CODEC_H
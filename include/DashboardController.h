@@ -4,59 +4,87 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <unordered_map>
 #include "VehicleConfig.h"
+#include "SignalRegistry.h"
+#include "DriveMode.h"
 
-// Observer pattern interface
+// Values shown by the dashboard, as last read from the store
+struct DashboardSnapshot {
+    uint16_t speed = 0;
+    uint16_t remainingRange = 0;
+    int batteryLevel = 0;
+    int climateTemp = 0;
+    int windLevel = 0;
+    int turnSignal = 0;
+    DriveMode::Mode driveMode = DriveMode::Mode::ECO;
+    bool isBrake = false;
+    bool isAccelerator = false;
+    bool acStatus = false;
+};
+
+// Signals behind the DashboardSnapshot fields, as signalBit() bits
+constexpr uint32_t DASHBOARD_SIGNALS =
+    signalBit(SignalId::VEHICLE_SPEED) | signalBit(SignalId::ROUTE_PLANNER) | signalBit(SignalId::BATTERY_LEVEL) |
+    signalBit(SignalId::AC_CONTROL) | signalBit(SignalId::WIND_LEVEL) | signalBit(SignalId::TURN_SIGNAL) |
+    signalBit(SignalId::DRIVE_MODE) | signalBit(SignalId::BRAKE) | signalBit(SignalId::ACCELERATOR) |
+    signalBit(SignalId::AC_STATUS);
+
+// Observer pattern interface. changed holds the signalBit() of every field
+// that differs from the previous notification; the first one has every
+// field that was read.
 class Observer {
 public:
-    virtual void update(
-        const uint16_t& speed,
-        const uint16_t& remainingRange,
-        const int& batteryLevel,
-        const int& climateTemp,
-        const int& windLevel,
-        const int& turnSignal,
-        const std::string& driveMode,
-        const bool& isBrake,
-        const bool& isAccelerator,
-        const bool& acStatus
-    ) = 0;
+    virtual void update(const DashboardSnapshot& snapshot, uint32_t changed) = 0;
 
     virtual ~Observer() {};
 };
 
-// Subject class (Observable)
+/**
+ * @brief DashboardController class
+ *
+ * Subject of the dashboard observers. readData() compares the frame with
+ * the current snapshot and notifies only when a field changed, so a store
+ * commit that touches nothing on screen (the odometer while cruising)
+ * costs the observers nothing. An observer registered later reads
+ * getSnapshot() for the fields it has not been notified of.
+ */
 class DashboardController {
 public:
     DashboardController();
     ~DashboardController();
 
-    void readData(const std::unordered_map<std::string, std::string>& newData);
-    
+    void readData(const SignalFrame& newData);
+
     // Observer pattern
     void registerObserver(Observer* observer);
     void unregisterObserver(Observer* observer);
-    void notifyObservers() const;
+    void notifyObservers(uint32_t changed) const;
 
     // getters
-    std::string getDriveMode() const { return driveMode; }
-    bool getIsBrake() const { return isBrake; }
-    bool getIsAccelerator() const { return isAccelerator; }
-    bool getAcStatus() const { return acStatus; }
-    uint16_t getSpeed() const { return speed; }
-    uint16_t getRemainingRange() const { return remainingRange; }
-    int getBatteryLevel() const { return batteryLevel; }
-    int getClimateTemp() const { return climateTemp; }
-    int getWindLevel() const { return windLevel; }
-    int getTurnSignal() const { return turnSignal; }
+    const DashboardSnapshot& getSnapshot() const { return snapshot; }
+    std::string getDriveMode() const { return snapshot.driveMode == DriveMode::Mode::SPORT ? "SPORT" : "ECO"; }
+    bool getIsBrake() const { return snapshot.isBrake; }
+    bool getIsAccelerator() const { return snapshot.isAccelerator; }
+    bool getAcStatus() const { return snapshot.acStatus; }
+    uint16_t getSpeed() const { return snapshot.speed; }
+    uint16_t getRemainingRange() const { return snapshot.remainingRange; }
+    int getBatteryLevel() const { return snapshot.batteryLevel; }
+    int getClimateTemp() const { return snapshot.climateTemp; }
+    int getWindLevel() const { return snapshot.windLevel; }
+    int getTurnSignal() const { return snapshot.turnSignal; }
+
+    uint64_t getReads() const { return reads; }                  // readData() calls
+    uint64_t getNotifications() const { return notifications; }  // readData() calls that notified
 
 private:
-    std::string driveMode;
-    bool isBrake, isAccelerator, acStatus;
-    uint16_t speed, remainingRange;
-    int batteryLevel, climateTemp, windLevel, turnSignal;
+    DashboardSnapshot snapshot;
+    uint32_t knownMask;         // fields read at least once
+    uint64_t reads;
+    uint64_t notifications;
 
     std::vector<Observer*> observers;
 };
 
-#endif // DASHBOARD_CONTROLLER_H
\ No newline at end of file
+#endif // DASHBOARD_CONTROLLER_H
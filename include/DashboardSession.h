@@ -0,0 +1,73 @@
+#ifndef DASHBOARD_SESSION_H
+#define DASHBOARD_SESSION_H
+
+#include "VehicleConfig.h"
+#include "DataHandler.h"
+#include "DashboardController.h"
+#include "SafetyManager.h"
+#include "DriveMode.h"
+#include "SimulationClock.h"
+#include "SpeedCalculator.h"
+#include "BatteryManager.h"
+#include "VehicleSimulation.h"
+#include "VehicleState.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief DashboardSession class
+ *
+ * One simulated dashboard with its own data store file, vehicle profile,
+ * DashboardController, SpeedCalculator and BatteryManager, on a fixed-step
+ * SimulationClock. Sessions share nothing but the read-only profile, so a
+ * SessionHost can run many of them in one process. The store is SERVICED:
+ * step() persists it on the stepping thread, so a session adds no threads.
+ *
+ * setInputs() is called by the one thread serving the session's driver and
+ * getState() by anyone; step() by one thread at a time. The controller is
+ * refreshed from the store inside step(), so observers run on that thread.
+ */
+class DashboardSession {
+public:
+    DashboardSession(int id, std::shared_ptr<const VehicleProfile> profile, const std::string& storePath,
+                     StorageBackend backend = StorageBackend::CSV, double step = SimulationClock::DEFAULT_STEP);
+    ~DashboardSession();
+
+    bool isOpen() const { return dataHandler != nullptr; }
+    int getId() const { return id; }
+    const VehicleProfile& getProfile() const { return *profile; }
+
+    void setInputs(const DriverInputs& inputs);     // driver controls for the next ticks
+    DriverInputs getInputs() const { return driverInputs.load(); }
+    void step();                                    // one tick: physics, store, controller, persist
+    VehicleState getState() const { return vehicleState.load(); }
+
+    const VehicleStateChannel* getStateChannel() const { return &vehicleState; }   // for a Display
+    DashboardController* getController() { return &dashboardController; }
+    DataHandler* getDataHandler() { return dataHandler.get(); }
+    double getBatteryKwH() const { return batteryManager.getBatteryKwH(); }
+    double getTotalDistance() const { return speedCalculator.getTotalDistance(); }
+
+private:
+    int id;
+    std::shared_ptr<const VehicleProfile> profile;
+    std::unique_ptr<DataHandler> dataHandler;
+    DashboardController dashboardController;
+    SafetyManager safetyManager;
+    DriveMode driveMode;
+    SimulationClock clock;
+    SpeedCalculator speedCalculator;
+    BatteryManager batteryManager;
+    std::unique_ptr<VehicleSimulation> simulation;
+
+    DriverInputChannel driverInputs;
+    VehicleStateChannel vehicleState;
+    DriverInputs storedInputs;      // driver controls last written to the store
+    StoredSignals stored;
+    uint64_t seenVersion;           // store version the controller was refreshed at
+
+    DriverInputs initStore();
+    void collectInputChanges(const DriverInputs& inputs, SignalBatch& updates);
+};
+
+#endif // DASHBOARD_SESSION_H
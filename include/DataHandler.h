@@ -3,28 +3,209 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <array>
+#include <atomic>
 #include <mutex>
-#include <fstream>
-#include <sstream>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <sys/types.h>
+#include "StateStorage.h"
+#include "LatencyHistogram.h"
+#include "MpscQueue.h"
 
-using CSVMap = std::unordered_map<std::string, std::string>;
+// Who drains a store's update queue and persists it
+enum class WriterMode {
+    THREAD,     // a writer thread of its own
+    SERVICED    // the owner's thread, in service(); a host's workers between ticks
+};
+
+// When the writer thread persists dirty keys to a write-behind backend
+struct FlushPolicy {
+    std::chrono::milliseconds interval{500};   // flush at least this often while dirty
+    size_t dirtyThreshold = 8;                 // flush early once this many keys are dirty
+};
+
+// Counters to measure how much file I/O the write-behind store saves
+struct DataHandlerStats {
+    uint64_t updateCalls = 0;       // number of updateData() / updateSignals() calls
+    uint64_t keyWrites = 0;         // number of key writes received
+    uint64_t coalescedWrites = 0;   // key writes merged into an already dirty key
+    uint64_t flushCount = 0;        // number of persisted batches / file rewrites
+    uint64_t keysFlushed = 0;       // number of dirty keys persisted
+    double lastFlushMs = 0.0;       // latency of the last flush
+    double maxFlushMs = 0.0;        // worst flush latency
+    double totalFlushMs = 0.0;      // sum of all flush latencies
+    uint64_t commandsEnqueued = 0;  // update commands pushed to the writer queue
+    uint64_t queueDepth = 0;        // commands waiting in the queue right now
+    uint64_t maxQueueDepth = 0;     // deepest the queue has been
+    uint64_t queueFullWaits = 0;    // producer retries because the queue was full
+    uint64_t batchCount = 0;        // non-empty drains of the queue
+    uint64_t maxBatchSize = 0;      // most commands drained at once
+};
 
+/**
+ * @brief DataHandler class
+ *
+ * Holds the authoritative vehicle state in memory, indexed by SignalId.
+ * The hot paths use readSignals() / updateSignals(); readData() and
+ * updateData() convert CSV names and text values at the boundary.
+ *
+ * Producers never touch the filesystem: a value is swapped into its atomic
+ * slot and an update command is pushed to a lock-free MPSC queue; a lock is
+ * only taken to wake a parked writer or a reader in waitForChange(). A
+ * single writer thread drains the queue, coalesces commands per key and
+ * persists them in batches: straight away for write-through
+ * backends (MAPPED, JOURNAL), on a configurable interval / dirty threshold
+ * for the CSV file, and always on shutdown.
+ *
+ * Every committed change bumps a version and wakes waitForChange(). An
+ * inotify watcher picks up writes to the backing file by other programs
+ * and merges them without reverting local updates that are not persisted
+ * yet;
+ * the MAPPED file's generation counter is polled instead, since stores
+ * through a mapping raise no inotify event.
+ * The JOURNAL backend appends each update to a write-ahead journal and
+ * replays it on startup, so the state survives a crash.
+ *
+ * getInstance() is the Dashboard's store on ../data/Database.csv; open()
+ * creates independent stores on other files for hosts running several
+ * vehicles in one process. A SERVICED store starts no threads: its owner
+ * calls service() regularly to do the writer's work, so a host's thread
+ * count does not grow with its stores.
+ */
 class DataHandler {
 private:
-    DataHandler(const std::string& filename);
+    DataHandler(std::unique_ptr<StateStorage> storage, StorageBackend backend, bool watchExternalWrites,
+                WriterMode writerMode);
+    static std::unique_ptr<StateStorage> createStorage(const std::string& csvPath, StorageBackend& backend,
+                                                       WriterMode writerMode);
 
     static DataHandler* instance;
     static std::mutex mtx; // variable to ensure thread safety
-    std::string filename;
-    
+    std::unique_ptr<StateStorage> storage;
+    StorageBackend backend;
+    WriterMode writerMode;
+
+    // The writer persists the latest value of the slot, so a command only names the key
+    struct UpdateCommand {
+        SignalId id;
+        int64_t enqueueNanos;
+    };
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    // In-memory authoritative state
+    std::array<std::atomic<double>, SIGNAL_COUNT> values;
+    std::atomic<uint32_t> presentMask;
+    std::mutex extrasMutex;
+    CSVMap extras;                          // keys outside the signal registry
+    std::unordered_set<std::string> dirtyExtras;
+
+    // Producers -> writer thread
+    MpscQueue<UpdateCommand, QUEUE_CAPACITY> queue;
+    std::mutex writerMutex;
+    std::condition_variable writerCv;
+    std::condition_variable flushDoneCv;
+    std::thread writer;
+    std::atomic<bool> writerIdle;
+    bool stopWriter;
+    bool writerExited;
+    uint64_t flushRequests;
+    uint64_t flushesDone;
+    FlushPolicy policy;
+    std::atomic<size_t> wakeThreshold;      // queue depth at which producers wake the writer
+
+    // Owned by the writer thread
+    uint32_t pendingMask;
+    std::array<int64_t, SIGNAL_COUNT> pendingSince;     // first enqueue time of each pending key
+    int64_t firstPendingNanos;
+    bool persistFailed;                     // back off to the interval after a failed write
+    std::mutex fileMutex;                   // serializes storage writes and reloads
+    // Signal values the backing storage holds, as last loaded or persisted, guarded by fileMutex
+    std::array<double, SIGNAL_COUNT> storedValues;
+    uint32_t storedMask;
+
+    // Statistics
+    std::atomic<uint64_t> updateCalls;
+    std::atomic<uint64_t> keyWrites;
+    std::atomic<uint64_t> commandsEnqueued;
+    std::atomic<uint64_t> maxQueueDepth;
+    std::atomic<uint64_t> queueFullWaits;
+    std::mutex statsMutex;
+    DataHandlerStats writerStats;           // guarded by statsMutex
+    LatencyHistogram durableLatency;
+
+    // Change notification
+    struct FileStamp {
+        ino_t inode = 0;
+        off_t size = -1;
+        int64_t modifiedNanos = 0;
+        bool operator==(const FileStamp& other) const {
+            return inode == other.inode && size == other.size && modifiedNanos == other.modifiedNanos;
+        }
+    };
+
+    std::atomic<uint64_t> version;
+    std::atomic<int64_t> lastCommitNanos;
+    std::atomic<int> changeWaiters;
+    std::atomic<bool> stopping;
+    std::mutex changeMutex;
+    std::condition_variable changeCv;
+    LatencyHistogram notifyLatency;
+    FileStamp lastSelfWrite;                // guarded by fileMutex
+    std::thread watcher;
+    int stopEventFd;
+
+    bool applySignal(SignalId id, double value);
+    bool applyExtra(const std::string& key, const std::string& value);
+    bool mergeFromStorage(const SignalFrame& frame, const CSVMap& data);   // values read back from storage are not queued
+    void markStored(const SignalFrame& frame);
+    void enqueue(const UpdateCommand& command);
+    void wakeWriter();
+    void commit();
+    CSVMap toCsv();
+
+    void writerLoop();
+    size_t drainQueue();
+    size_t pendingCount();
+    bool isFlushDue(const FlushPolicy& current);
+    bool persistPending();
+
+    void watchLoop();
+    void reloadExternalChange();
+    FileStamp stampFile() const;
+
 public:
-    ~DataHandler() = default;
+    ~DataHandler();
 
-    static DataHandler* getInstance();
+    static DataHandler* getInstance(StorageBackend backend = StorageBackend::CSV);
+    static std::unique_ptr<DataHandler> open(const std::string& csvPath, StorageBackend backend = StorageBackend::CSV,
+                                             bool watchExternalWrites = true,    // the binary and journal files sit next to csvPath
+                                             WriterMode writerMode = WriterMode::THREAD);
     CSVMap readData();
     void updateData(const CSVMap& updates);
+    SignalFrame readSignals();
+    void updateSignals(const SignalBatch& updates);
     std::string getValue(const std::string& key);
+
+    void setFlushPolicy(const FlushPolicy& newPolicy);
+    void flush();       // persist everything queued so far and wait for it
+    void service();     // SERVICED stores: drain the queue and persist what the flush policy says is due
+    void shutdown();    // stop the writer after a final flush
+    DataHandlerStats getStats();
+    const LatencyHistogram& getDurableLatency() const { return durableLatency; }   // enqueue-to-durable
+
+    // Change notification
+    uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+    bool waitForChange(uint64_t& seenVersion, std::chrono::milliseconds timeout);
+    const LatencyHistogram& getNotifyLatency() const { return notifyLatency; }
+
+    StorageBackend getBackend() const { return backend; }
+    bool hasRecoveredState() const { return storage->hasRecoveredState(); }
+    bool exportCsv(const std::string& csvPath);
 };
 
-#endif // DATA_HANDLER_H
\ No newline at end of file
+#endif // DATA_HANDLER_H
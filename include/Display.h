@@ -2,14 +2,15 @@
 #define DISPLAY_H
 
 #include "DashboardController.h"
+#include "VehicleState.h"
 #include <iomanip>  // For std::setprecision
 
 class Display : public Observer {
 public:
-    Display(DashboardController* dashboardController);
+    Display(DashboardController* dashboardController, const VehicleStateChannel* vehicleState = nullptr);
     ~Display();
 
-    void updateDisplay(); // Update display from DashboardController
+    void updateDisplay(); // Update display from the vehicle state snapshot, or DashboardController
 
     void showSpeed(const uint16_t& speed);
     void showBatteryLevel(const int& batteryLevel);
@@ -21,28 +22,12 @@ public:
     void showGasPressed(const bool& isAccelerator);
     void showWarningAction();
 
-    void update(
-        const uint16_t& speed,
-        const uint16_t& remainingRange,
-        const int& batteryLevel,
-        const int& climateTemp,
-        const int& windLevel,
-        const int& turnSignal,
-        const std::string& driveMode,
-        const bool& isBrake,
-        const bool& isAccelerator,
-        const bool& acStatus
-    ) override;
+    void update(const DashboardSnapshot& state, uint32_t changed) override;
 
 private:
     DashboardController* dashboardController;
+    const VehicleStateChannel* vehicleState;
+    VehicleState snapshot; // consistent state of one physics tick
 };
 
-extern int outputPower;            
-extern double updateOdometer;      
-extern double updateBatteryTemp;   
-extern bool isSafetyAction;        
-extern int gasIntensityDisplay;
-extern int brakeIntensityDisplay;
-
 #endif // DISPLAY_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef DRIVE_CYCLE_H
+#define DRIVE_CYCLE_H
+
+#include <string>
+#include <vector>
+#include "VehicleState.h"
+
+// Constant driver inputs for a stretch of the cycle
+struct CycleSegment {
+    double duration;        // s
+    DriverInputs inputs;
+};
+
+/**
+ * @brief DriveCycle class
+ *
+ * A repeatable driver: pedal, drive-mode and AC timelines as a list of
+ * segments, played back by simulated time and looped from the start when
+ * they run out. builtIn() holds the standard set used to compare the
+ * physics and battery model between builds: urban stop-and-go, highway
+ * cruise, aggressive sport and a four-phase WLTP-like cycle. The pedals are
+ * on/off, as on the keyboard, so the speed traces only resemble the
+ * originals.
+ */
+class DriveCycle {
+public:
+    DriveCycle(const std::string& name, const std::vector<CycleSegment>& segments);
+
+    static const std::vector<DriveCycle>& builtIn();
+    static const DriveCycle* find(const std::string& name);    // nullptr if not built in
+
+    DriverInputs inputsAt(double seconds) const;
+    const std::string& getName() const { return name; }
+    double getDuration() const { return duration; }             // s, one pass
+    const std::vector<CycleSegment>& getSegments() const { return segments; }
+
+private:
+    std::string name;
+    std::vector<CycleSegment> segments;
+    std::vector<double> ends;       // s, end of each segment within one pass
+    double duration;
+};
+
+#endif // DRIVE_CYCLE_H
@@ -1,6 +1,8 @@
 #ifndef DRIVE_MODE_H
 #define DRIVE_MODE_H
 
+struct VehicleProfile;
+
 struct DriveModeFactor {
     double ECO = 0.60;   
     double SPORT = 0.80; 
@@ -10,9 +12,11 @@ class DriveMode {
 public:
     enum class Mode {ECO, SPORT};
 
-    DriveMode();
+    DriveMode();                                    // the ElectricVehicleInit profile
+    DriveMode(const VehicleProfile& profile);
     ~DriveMode();
 
+    void setProfile(const VehicleProfile& profile);  // power outputs of another profile
     void setMode(Mode mode);
     Mode getMode() const {return currentMode;}
 
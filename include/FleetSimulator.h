@@ -0,0 +1,107 @@
+#ifndef FLEET_SIMULATOR_H
+#define FLEET_SIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ProfileTables.h"
+#include "SimulationClock.h"
+#include "ThreadPool.h"
+#include "VehicleConfig.h"
+#include "VehicleState.h"
+
+/**
+ * @brief FleetSimulator class
+ *
+ * Steps many vehicles of one profile at once.
+ * Every per-vehicle quantity lives in its own contiguous array (structure
+ * of arrays), so one tick streams through memory and splits into
+ * independent index ranges for the ThreadPool.
+ *
+ * A tick applies the same rules, in the same order, as
+ * VehicleSimulation::step() with its DriveMode, SafetyManager,
+ * SpeedCalculator and BatteryManager: a vehicle in the fleet produces the
+ * same outputs as a single car fed the same inputs. The remaining range is
+ * the one exception: it is the RangeModel::EMA estimate
+ * (BatteryManager::calculateEmaRange), whatever model the BatteryManager
+ * uses. The energy map keeps a kWh/km table per vehicle, too much state to
+ * carry for every lane; MonteCarloRange reads only the kWh and distance.
+ */
+class FleetSimulator {
+public:
+    static constexpr size_t GRAIN = 2048;   // vehicles per parallel chunk
+
+    FleetSimulator(size_t vehicleCount, SimulationClock* clock, ThreadPool* pool);   // the ElectricVehicleInit profile
+    FleetSimulator(size_t vehicleCount, SimulationClock* clock, ThreadPool* pool, const VehicleProfile& profile);
+
+    size_t size() const { return vehicleCount; }
+    void setInputs(size_t vehicle, const DriverInputs& inputs);
+    void setEnvironment(size_t vehicle, double environmentTemp, int load);  // defaults 35 C and 200 kg, as the components
+    void resetVehicle(size_t vehicle, int speed, double kwh);               // back to a fresh car moving at speed km/h
+    void step();                                // advance every vehicle by the clock's current tick
+    void stepRange(size_t begin, size_t end);   // advance vehicles [begin, end) only
+
+    int getSpeed(size_t vehicle) const { return speed[vehicle]; }
+    double getKwH(size_t vehicle) const { return currentKwH[vehicle]; }
+    double getBatteryLevel(size_t vehicle) const { return batteryLevel[vehicle]; }
+    double getRemainingRange(size_t vehicle) const { return remainingRange[vehicle]; }   // EMA estimate
+    double getBatteryTemp(size_t vehicle) const { return batteryTemp[vehicle]; }
+    double getOdometer(size_t vehicle) const { return distanceMeters[vehicle] / 1000.0; }
+    int getAcceleratorIntensity(size_t vehicle) const { return acceleratorIntensity[vehicle]; }
+    int getBrakeIntensity(size_t vehicle) const { return brakeIntensity[vehicle]; }
+    double getTotalKwH() const;
+
+private:
+    static constexpr int8_t NO_MODE = -1;
+
+    size_t vehicleCount;
+    SimulationClock* clock;
+    ThreadPool* pool;
+
+    // Profile values, shared by every vehicle
+    int maxSpeedEco;
+    int maxSpeedSport;
+    int vehicleWeight;
+    double batteryMaxCapacity;
+    int maxRange;
+    int maxAcPower;
+    std::shared_ptr<const ProfileTables> tables;
+
+    // Inputs
+    std::vector<uint8_t> accelerator;
+    std::vector<uint8_t> brake;
+    std::vector<uint8_t> sport;
+    std::vector<int> acTemp;
+    std::vector<int> windLevel;
+    std::vector<double> environmentTemp;
+    std::vector<int> totalWeight;           // vehicle plus load
+
+    // Drive mode and pedals (DriveMode, SafetyManager)
+    std::vector<uint8_t> activeSport;       // mode the vehicle is in
+    std::vector<uint8_t> ecoModeChanged;    // slowing down to the ECO limit after leaving SPORT
+    std::vector<int> acceleratorIntensity;
+    std::vector<int> brakeIntensity;
+
+    // Speed (SpeedCalculator)
+    std::vector<int> speed;                 // reported km/h
+    std::vector<int> calculatedSpeed;       // last km/h from the traction model
+    std::vector<int> lastSpeed;
+    std::vector<int8_t> lastDriveMode;      // NO_MODE, 0 = ECO, 1 = SPORT
+    std::vector<double> lastAcceleration;
+    std::vector<double> distanceMeters;
+    std::vector<double> powerConsumption;
+
+    // Battery (BatteryManager)
+    std::vector<double> currentKwH;
+    std::vector<double> batteryLevel;
+    std::vector<double> drainPerKm;
+    std::vector<double> previousDrainPerKm;
+    std::vector<double> remainingRange;
+    std::vector<double> batteryTemp;
+
+    void updateBattery(size_t i, double deltaTime);
+    void updateSpeed(size_t i, double deltaTime);
+};
+
+#endif // FLEET_SIMULATOR_H
@@ -0,0 +1,170 @@
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+enum class IntegratorMethod {
+    EULER,                  // one explicit step per tick; SpeedCalculator keeps its original int km/h path
+    SEMI_IMPLICIT_EULER,    // new speed first, position from the new speed
+    RK4,                    // classic fourth-order Runge-Kutta
+    RK45                    // Dormand-Prince 5(4) with error-controlled sub-steps
+};
+
+// Longitudinal state of one vehicle
+struct MotionState {
+    double position = 0.0;  // m
+    double speed = 0.0;     // m/s, never negative
+};
+
+struct IntegratorStats {
+    uint64_t steps = 0;         // accepted sub-steps
+    uint64_t rejected = 0;      // RK45 sub-steps retried with a smaller step
+    uint64_t evaluations = 0;   // calls of the acceleration function
+};
+
+/**
+ * @brief Integrator class
+ *
+ * Advances speed and position over one tick for an acceleration that
+ * depends on speed only, the tick's pedal levels being held. The
+ * fixed-step methods split the tick into sub-steps of at most maxStep;
+ * RK45 sizes its sub-steps from the difference between its fifth and
+ * fourth order solutions, keeping the local error below tolerance relative
+ * to 1 + |value|, and carries the step size over to the next tick. The
+ * vehicle does not reverse: speed is clamped at zero after every sub-step.
+ */
+class Integrator {
+public:
+    static constexpr double DEFAULT_TOLERANCE = 1e-6;
+    static constexpr double DEFAULT_MAX_STEP = 0.01;   // s, sub-step of the fixed-step methods
+    static constexpr double MIN_STEP = 1e-6;           // s, RK45 accepts any error at this step
+
+    Integrator(IntegratorMethod method, double tolerance = DEFAULT_TOLERANCE, double maxStep = DEFAULT_MAX_STEP);
+
+    IntegratorMethod getMethod() const { return method; }
+    const IntegratorStats& getStats() const { return stats; }
+
+    static const char* methodName(IntegratorMethod method);
+    static bool parseMethod(const std::string& name, IntegratorMethod& method);  // euler, semi-implicit, rk4, rk45
+
+    // acceleration(speed) returns m/s^2 for a speed in m/s
+    template <typename Acceleration>
+    void advance(MotionState& state, double dt, const Acceleration& acceleration);
+
+private:
+    IntegratorMethod method;
+    double tolerance;
+    double maxStep;
+    double nextStep;        // RK45 step size proposed by the last accepted sub-step
+    IntegratorStats stats;
+
+    template <typename Acceleration>
+    double evaluate(const Acceleration& acceleration, double speed) {
+        stats.evaluations++;
+        return acceleration(speed);
+    }
+
+    template <typename Acceleration>
+    void advanceRk45(MotionState& state, double dt, const Acceleration& acceleration);
+};
+
+template <typename Acceleration>
+void Integrator::advance(MotionState& state, double dt, const Acceleration& acceleration) {
+    if (dt <= 0.0) {
+        return;
+    }
+    if (method == IntegratorMethod::RK45) {
+        advanceRk45(state, dt, acceleration);
+        return;
+    }
+
+    int count = method == IntegratorMethod::EULER ? 1 : std::max(1, static_cast<int>(std::ceil(dt / maxStep - 1e-9)));
+    double h = dt / count;
+    for (int i = 0; i < count; i++) {
+        double v = state.speed;
+        if (method == IntegratorMethod::EULER) {
+            state.position += v * h;
+            state.speed = v + evaluate(acceleration, v) * h;
+        } else if (method == IntegratorMethod::SEMI_IMPLICIT_EULER) {
+            state.speed = std::max(v + evaluate(acceleration, v) * h, 0.0);
+            state.position += state.speed * h;
+        } else {
+            double a1 = evaluate(acceleration, v);
+            double v2 = v + 0.5 * h * a1;
+            double a2 = evaluate(acceleration, v2);
+            double v3 = v + 0.5 * h * a2;
+            double a3 = evaluate(acceleration, v3);
+            double v4 = v + h * a3;
+            double a4 = evaluate(acceleration, v4);
+            state.position += h / 6.0 * (v + 2.0 * v2 + 2.0 * v3 + v4);
+            state.speed = v + h / 6.0 * (a1 + 2.0 * a2 + 2.0 * a3 + a4);
+        }
+        state.speed = std::max(state.speed, 0.0);
+        stats.steps++;
+    }
+}
+
+// Position' = speed, so the position stages are the stage speeds
+template <typename Acceleration>
+void Integrator::advanceRk45(MotionState& state, double dt, const Acceleration& acceleration) {
+    double elapsed = 0.0;
+    double h = std::min(nextStep, dt);
+    double a1 = evaluate(acceleration, state.speed);
+    while (elapsed < dt) {
+        double remaining = dt - elapsed;
+        double proposed = h;
+        bool last = h >= remaining;
+        if (last) h = remaining;
+
+        double v = state.speed;
+        double v2 = v + h * (a1 / 5.0);
+        double a2 = evaluate(acceleration, v2);
+        double v3 = v + h * (3.0 / 40.0 * a1 + 9.0 / 40.0 * a2);
+        double a3 = evaluate(acceleration, v3);
+        double v4 = v + h * (44.0 / 45.0 * a1 - 56.0 / 15.0 * a2 + 32.0 / 9.0 * a3);
+        double a4 = evaluate(acceleration, v4);
+        double v5 = v + h * (19372.0 / 6561.0 * a1 - 25360.0 / 2187.0 * a2 + 64448.0 / 6561.0 * a3 - 212.0 / 729.0 * a4);
+        double a5 = evaluate(acceleration, v5);
+        double v6 = v + h * (9017.0 / 3168.0 * a1 - 355.0 / 33.0 * a2 + 46732.0 / 5247.0 * a3 + 49.0 / 176.0 * a4
+                             - 5103.0 / 18656.0 * a5);
+        double a6 = evaluate(acceleration, v6);
+        double newSpeed = v + h * (35.0 / 384.0 * a1 + 500.0 / 1113.0 * a3 + 125.0 / 192.0 * a4
+                                   - 2187.0 / 6784.0 * a5 + 11.0 / 84.0 * a6);
+        double newPosition = state.position + h * (35.0 / 384.0 * v + 500.0 / 1113.0 * v3 + 125.0 / 192.0 * v4
+                                                   - 2187.0 / 6784.0 * v5 + 11.0 / 84.0 * v6);
+        double a7 = evaluate(acceleration, newSpeed);
+
+        // Fifth minus fourth order solution
+        const double E1 = 71.0 / 57600.0, E3 = -71.0 / 16695.0, E4 = 71.0 / 1920.0;
+        const double E5 = -17253.0 / 339200.0, E6 = 22.0 / 525.0, E7 = -1.0 / 40.0;
+        double speedError = h * (E1 * a1 + E3 * a3 + E4 * a4 + E5 * a5 + E6 * a6 + E7 * a7);
+        double positionError = h * (E1 * v + E3 * v3 + E4 * v4 + E5 * v5 + E6 * v6 + E7 * newSpeed);
+        double error = std::max(
+            std::abs(speedError) / (tolerance * (1.0 + std::max(std::abs(v), std::abs(newSpeed)))),
+            std::abs(positionError) / (tolerance * (1.0 + std::max(std::abs(state.position), std::abs(newPosition)))));
+        double factor = error > 0.0 ? std::min(5.0, std::max(0.2, 0.9 * std::pow(error, -0.2))) : 5.0;
+
+        if (error > 1.0 && h > MIN_STEP) {
+            stats.rejected++;
+            h = std::max(h * factor, MIN_STEP);
+            continue;
+        }
+        stats.steps++;
+        elapsed = last ? dt : elapsed + h;
+        state.position = newPosition;
+        state.speed = newSpeed;
+        a1 = a7;
+        if (state.speed < 0.0) {
+            state.speed = 0.0;
+            a1 = evaluate(acceleration, 0.0);
+        }
+        // A step cut short by the end of the tick does not shrink the next tick's first step
+        h = std::min(std::max(h * factor, last ? proposed : 0.0), maxStep * 100.0);
+    }
+    nextStep = h;
+}
+
+#endif // INTEGRATOR_H
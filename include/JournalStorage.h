@@ -0,0 +1,75 @@
+#ifndef JOURNAL_STORAGE_H
+#define JOURNAL_STORAGE_H
+
+#include "StateStorage.h"
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @brief JournalStorage class
+ *
+ * Write-ahead journal backend. Every key write is appended to the journal as
+ * one compact record:
+ *
+ *     [crc32 : 4][key length : 1][value length : 1][key][value]
+ *
+ * Once the journal grows past the compaction threshold a background thread
+ * rotates it to "<journal>.old", writes the full state as the CSV snapshot
+ * (temp file + rename) and deletes the rotated journal. Recovery loads the
+ * snapshot and replays "<journal>.old" and the active journal on top of it,
+ * stopping at the first torn or corrupt record. Without the background
+ * thread, the owner compacts in maintain() instead.
+ */
+class JournalStorage : public StateStorage {
+public:
+    static constexpr size_t DEFAULT_COMPACT_THRESHOLD = 64 * 1024;
+
+    JournalStorage(const std::string& snapshotPath, const std::string& journalPath,
+                   size_t compactThresholdBytes = DEFAULT_COMPACT_THRESHOLD, bool compactInBackground = true);
+    ~JournalStorage();
+
+    CSVMap load() override;
+    bool persist(const CSVMap& data) override;
+    bool isWriteThrough() const override { return true; }
+    bool supportsExternalWriters() const override { return false; }
+    bool store(const std::string& key, const std::string& value) override;
+    bool storeBatch(const SignalBatch& batch) override;    // one write() for the whole batch
+    void sync() override;
+    void maintain() override;
+    std::string getPath() const override { return snapshotPath; }
+    bool hasRecoveredState() const override { return recovered; }
+
+    size_t getRecoveredRecords() const { return recoveredRecords; }
+    size_t getCompactionCount() const { return compactionCount; }
+
+private:
+    std::string snapshotPath;
+    std::string journalPath;
+    std::string rotatedPath;
+    size_t compactThreshold;
+
+    std::mutex journalMutex;
+    std::condition_variable compactCv;
+    std::thread compactor;
+    bool stopCompactor;
+    bool compactRequested;
+
+    int fd;
+    size_t journalBytes;
+    CSVMap state;               // state as of the last appended record
+    bool recovered;
+    size_t recoveredRecords;
+    size_t compactionCount;
+
+    bool append(const uint8_t* records, size_t size, const CSVMap& applied);
+    bool recover();
+    size_t replay(const std::string& path, bool truncateTornTail);
+    bool openJournal();
+    bool writeSnapshot(const CSVMap& snapshot);
+    bool compact();
+    void compactLoop();
+};
+
+#endif // JOURNAL_STORAGE_H
@@ -0,0 +1,39 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief LatencyHistogram class
+ *
+ * Lock-free log2 histogram of latencies in microseconds. Bucket i counts
+ * samples in [2^(i-1), 2^i) us, bucket 0 counts samples below 1 us.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 32;
+
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+    void reset();
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    double getMeanMicros() const;
+    double getMaxMicros() const { return maxNanos.load(std::memory_order_relaxed) / 1000.0; }
+    double getPercentileMicros(double percentile) const;   // upper bound of the bucket holding the percentile
+
+    void print(std::ostream& out, const std::string& title) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> totalNanos;
+    std::atomic<uint64_t> maxNanos;
+};
+
+#endif // LATENCY_HISTOGRAM_H
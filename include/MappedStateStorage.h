@@ -0,0 +1,95 @@
+#ifndef MAPPED_STATE_STORAGE_H
+#define MAPPED_STATE_STORAGE_H
+
+#include "StateStorage.h"
+#include <cstdint>
+#include <cstddef>
+
+constexpr char MAPPED_STATE_MAGIC[8] = {'C', 'A', 'R', 'S', 'T', 'A', 'T', 'E'};
+constexpr uint32_t MAPPED_STATE_VERSION = 2;
+
+/**
+ * File layout shared with other processes. The header is followed by
+ * SIGNAL_COUNT 8-byte slots in SignalId order, each holding the signal value
+ * as IEEE-754 double bits. Every slot and counter is naturally aligned and
+ * accessed with atomic loads/stores, so a reader never sees a half-written
+ * value.
+ */
+struct MappedStateHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotCount;
+    uint64_t presentMask;   // bit i is set once slot i has been written
+    uint64_t generation;    // bumped after every slot store
+    uint64_t reserved[4];
+};
+static_assert(sizeof(MappedStateHeader) == 64, "header must stay 64 bytes");
+
+struct MappedStateSlot {
+    uint64_t word;
+};
+
+/**
+ * @brief MappedStateStorage class
+ *
+ * Write-through backend: an update is one aligned 8-byte store into the
+ * mapped file. A missing or incompatible file is created and seeded from
+ * the CSV import file. Keys outside the signal registry stay in
+ * DataHandler's memory only.
+ *
+ * Stores through another process's mapping raise no inotify event, so
+ * DataHandler polls hasExternalChange(): the header generation has moved
+ * past the stores made through this object.
+ */
+class MappedStateStorage : public StateStorage {
+public:
+    MappedStateStorage(const std::string& path, const std::string& importCsv);
+    ~MappedStateStorage();
+
+    CSVMap load() override;
+    bool persist(const CSVMap& data) override;
+    bool isWriteThrough() const override { return true; }
+    bool store(const std::string& key, const std::string& value) override;
+    bool storeSignal(SignalId id, double value) override;
+    void sync() override;
+    bool pollsExternalWriters() const override { return true; }
+    bool hasExternalChange() override;
+    std::string getPath() const override { return path; }
+
+    bool isOpen() const { return header != nullptr; }
+
+private:
+    std::string path;
+    int fd;
+    size_t mappedSize;
+    MappedStateHeader* header;
+    MappedStateSlot* slots;
+    uint64_t seenGeneration;        // generation after our last store or poll
+    bool externalStore;             // another writer stored between two of ours
+};
+
+/**
+ * @brief MappedStateView class
+ *
+ * Read-only mapping of a state file owned by another process.
+ * Poll getGeneration() to detect changes cheaply.
+ */
+class MappedStateView {
+public:
+    MappedStateView(const std::string& path);
+    ~MappedStateView();
+
+    bool isOpen() const { return header != nullptr; }
+    uint64_t getGeneration() const;
+    bool readSignal(SignalId id, double& value) const;
+    SignalFrame readFrame() const;
+    CSVMap readAll() const;
+
+private:
+    int fd;
+    size_t mappedSize;
+    const MappedStateHeader* header;
+    const MappedStateSlot* slots;
+};
+
+#endif // MAPPED_STATE_STORAGE_H
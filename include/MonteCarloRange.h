@@ -0,0 +1,126 @@
+#ifndef MONTE_CARLO_RANGE_H
+#define MONTE_CARLO_RANGE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FleetSimulator.h"
+#include "SeqLock.h"
+#include "SimulationClock.h"
+#include "ThreadPool.h"
+#include "VehicleConfig.h"
+#include "VehicleState.h"
+
+struct RangePercentiles {
+    double p10 = 0.0;       // km, 90 % of the samples reach further
+    double p50 = 0.0;
+    double p90 = 0.0;
+    size_t samples = 0;     // samples behind the estimate, 0 before the first refresh
+};
+
+/**
+ * @brief MonteCarloRange class
+ *
+ * Distribution of the remaining range under uncertain conditions. Each
+ * sample drives the current car forward for HORIZON_SECONDS with its own
+ * ambient temperature, AC setpoint, fan level, load and driving style,
+ * drawn around the conditions and the style observed on the real car, and
+ * keeps the kWh/km it measured. The samples are lanes of a FleetSimulator,
+ * spread over the ThreadPool; sample i of refresh generation g draws from
+ * RandomStream stream g * samples + i, so results do not depend on the
+ * thread count.
+ *
+ * refresh() re-simulates only the oldest samples, so the distribution
+ * follows the driving a slice at a time. refreshAsync() hands the slice to
+ * a background thread and returns at once; the quantiles of the previous
+ * slice stay published until the new ones are swapped in through a
+ * SeqLock. estimate() divides the current charge by the published
+ * consumption quantiles and is O(1).
+ */
+class MonteCarloRange {
+public:
+    static constexpr double HORIZON_SECONDS = 600.0;   // simulated ahead by each sample
+    static constexpr double STYLE_SECONDS = 300.0;     // time constant of the observed driving style
+    static constexpr size_t GRAIN = 8;                 // samples per parallel chunk
+    static constexpr size_t DEFAULT_SAMPLES = 2048;
+
+    MonteCarloRange(const VehicleProfile& profile, size_t sampleCount, ThreadPool* pool, uint64_t seed = 1);
+    ~MonteCarloRange();     // waits for a running slice
+
+    void observe(const DriverInputs& inputs, int speed, double deltaTime);  // every tick of the real car
+    void refresh(size_t count);                         // re-simulate the count oldest samples from now
+    bool refreshAsync(size_t count);                    // same in the background; false while a slice still runs
+    RangePercentiles estimate(double currentKwH) const;
+
+    size_t getSampleCount() const { return consumption.size(); }
+    uint64_t getSimulations() const { return simulations.load(std::memory_order_relaxed); }
+    bool isRefreshing() const { return refreshing.load(std::memory_order_acquire); }
+
+private:
+    // Driving style, as shares of time
+    struct Style {
+        double period = 70.0;           // s from one press of the accelerator to the next
+        double throttle = 30.0 / 70.0;
+        double brake = 10.0 / 70.0;
+        double sport = 0.0;
+    };
+
+    // What a slice starts from, copied when it starts
+    struct Observed {
+        Style style;
+        DriverInputs current;
+        int currentSpeed = 0;
+    };
+
+    // Published by the thread that finished a slice
+    struct Quantiles {
+        double p10 = 0.0;   // kWh/km
+        double p50 = 0.0;
+        double p90 = 0.0;
+        size_t filled = 0;
+    };
+
+    SimulationClock clock;              // never ticked after the first step; the fleet reads its step
+    FleetSimulator fleet;
+    ThreadPool* pool;
+    uint64_t seed;
+    double batteryMaxCapacity;
+    int maxRange;
+    int acTempMin;
+    int acTempMax;
+    int windLevelMax;
+
+    // Touched only by the thread running a slice
+    std::vector<double> consumption;    // kWh/km per sample
+    std::vector<uint64_t> generation;   // refreshes of each sample
+    size_t nextSample;
+    size_t filled;
+    std::atomic<uint64_t> simulations;
+    SeqLock<Quantiles> quantiles;
+
+    // Observed on the real car, by the thread calling observe()
+    Observed observed;
+    bool accelerating;
+    double sincePress;
+
+    // Background slice, guarded by refreshMutex
+    std::thread refresher;
+    std::mutex refreshMutex;
+    std::condition_variable refreshCv;
+    std::atomic<bool> refreshing;
+    bool refreshPending;
+    bool stopping;
+    size_t pendingCount;
+    Observed pending;
+
+    void runSlice(size_t count, const Observed& start);
+    void simulate(size_t sample, const Observed& start);
+    void publishQuantiles();
+    void refreshLoop();
+};
+
+#endif // MONTE_CARLO_RANGE_H
@@ -0,0 +1,76 @@
+#ifndef PACK_THERMAL_MODEL_H
+#define PACK_THERMAL_MODEL_H
+
+#include <cstddef>
+#include <vector>
+
+// Defaults: 96 cell groups in series, about a 75 kWh pack, coolant at the ENVIRONMENT_TEMP of BatteryManager
+struct PackThermalConfig {
+    int cellCount = 96;
+    int columns = 24;                   // cells along the coolant path; rows = cellCount / columns
+    double cellHeatCapacity = 5000.0;   // J/K per cell group
+    double cellResistance = 0.0008;     // ohm per cell group
+    double resistanceSpread = 0.05;     // cell-to-cell variation, +- share of cellResistance
+    double cellVoltage = 3.7;           // V, nominal
+    double neighbourConductance = 2.0;  // W/K between adjacent cells
+    double coolingConductance = 4.0;    // W/K from a cell at the coolant inlet to the coolant
+    double outletCooling = 0.6;         // share of coolingConductance left at the outlet
+    double coolantTemp = 35.0;          // C, also the starting temperature
+};
+
+/**
+ * @brief PackThermalModel class
+ *
+ * Temperature of every cell group of the pack instead of one lumped value.
+ * The cells form a rows x columns grid; each one heats by I^2 R for the
+ * pack current, exchanges heat with its four neighbours and loses heat to
+ * a coolant that warms along the columns, so cells near the outlet cool
+ * less. The grid is stored with a ring of ghost cells copied from the edge
+ * (an insulated pack), so every cell goes through the same
+ * VehicleKernels::cellTemp stencil with no edge cases. Ticks longer than
+ * the stability limit of the explicit step are split into sub-steps.
+ */
+class PackThermalModel {
+public:
+    static constexpr double TICK_BUDGET_NS = 2000.0;   // update() of the default 96-cell pack
+    static constexpr double STABLE_FRACTION = 0.5;      // largest share of a cell's heat exchanged in one sub-step
+
+    PackThermalModel(const PackThermalConfig& config = PackThermalConfig());
+
+    void update(double packPowerW, double deltaTime);  // power drawn from the pack over the tick, W
+
+    int getCellCount() const { return rows * columns; }
+    int getRows() const { return rows; }
+    int getColumns() const { return columns; }
+    double getCellTemp(int row, int column) const { return temp[(row + 1) * stride + column + 1]; }
+    double getMaxTemp() const { return maxTemp; }
+    double getMinTemp() const { return minTemp; }
+    double getMeanTemp() const { return meanTemp; }
+    double getSpread() const { return maxTemp - minTemp; }
+    double getHeatPower() const { return heatPower; }   // W, all cells during the last tick
+    const PackThermalConfig& getConfig() const { return config; }
+
+private:
+    PackThermalConfig config;
+    int rows;
+    int columns;
+    size_t stride;                  // columns + 2 ghost cells
+    std::vector<double> temp;       // (rows + 2) x stride, ghost ring included
+    std::vector<double> next;
+    std::vector<double> heat;       // K/s per A^2, zero on the ghost ring
+    std::vector<double> cooling;    // 1/s to the coolant, zero on the ghost ring
+    double conduction;              // 1/s to each neighbour
+    double maxRate;                 // 1/s, fastest total exchange of any cell
+    double packVoltage;
+    double totalResistance;
+
+    double maxTemp;
+    double minTemp;
+    double meanTemp;
+    double heatPower;
+
+    void copyGhosts();
+    void updateStats();
+};
+
+#endif // PACK_THERMAL_MODEL_H
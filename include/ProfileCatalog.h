@@ -0,0 +1,90 @@
+#ifndef PROFILE_CATALOG_H
+#define PROFILE_CATALOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "VehicleConfig.h"
+
+/**
+ * @brief ProfileCatalog class
+ *
+ * Vehicle models read from a CSV catalog instead of VehicleConfig.cpp.
+ * The header row names the columns: name, brand, option and one column per
+ * VehicleAttribute (attributeName), in any order; every attribute must be
+ * present. Lines starting with '#' are comments. A row with a bad value or
+ * a duplicate name is reported and skipped.
+ *
+ * The file is parsed once into one array of design values and a
+ * name-sorted index into a single buffer of names, so find() is a binary
+ * search over contiguous memory. Tables are built only by createProfile().
+ */
+class ProfileCatalog {
+public:
+    static constexpr const char* DEFAULT_PATH = "../data/Profiles.csv";
+
+    static std::shared_ptr<const ProfileCatalog> load(const std::string& path);  // nullptr if unreadable or invalid
+
+    size_t size() const { return entries.size(); }
+    int find(std::string_view name) const;                  // -1 if the catalog has no such model
+    std::string_view getName(size_t index) const;
+    const vehicleBaseParam& getDesignValues(size_t index) const { return entries[index].design; }
+    VehicleBrand getBrand(size_t index) const { return entries[index].brand; }
+    VehicleOption getOption(size_t index) const { return entries[index].option; }
+    std::shared_ptr<const VehicleProfile> createProfile(size_t index) const;
+    size_t getIndexBytes() const;                           // memory of the parsed catalog
+
+private:
+    struct Entry {
+        vehicleBaseParam design;
+        VehicleBrand brand;
+        VehicleOption option;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+
+    std::vector<Entry> entries;         // file order
+    std::vector<uint32_t> byName;       // entry indices sorted by name
+    std::string names;                  // every name, back to back
+
+    bool parse(const std::string& path, const std::string& text);
+};
+
+/**
+ * @brief ProfileWatcher class
+ *
+ * Hot reload of one model of a catalog. A thread waits for the catalog
+ * file to be rewritten (inotify, as DataHandler), parses it and builds the
+ * new profile with its tables, all off the physics thread. The physics
+ * loop calls takeUpdate() between ticks and applies a non-null result to
+ * its components; taking it is a pointer swap, so the loop never waits for
+ * a reload. A catalog that fails to parse, or no longer has the model,
+ * keeps the current profile.
+ */
+class ProfileWatcher {
+public:
+    ProfileWatcher(const std::string& catalogPath, const std::string& profileName,
+                   std::shared_ptr<const VehicleProfile> current);
+    ~ProfileWatcher();
+
+    std::shared_ptr<const VehicleProfile> takeUpdate();     // nullptr unless the model changed since the last call
+    uint64_t getReloads() const { return reloads.load(); }  // profiles published
+
+private:
+    std::string path;
+    std::string name;
+    std::shared_ptr<const VehicleProfile> current;          // watcher thread only
+    std::shared_ptr<const VehicleProfile> pending;          // std::atomic_load / atomic_exchange only
+    std::atomic<uint64_t> reloads;
+    int stopEventFd;
+    std::thread watcher;
+
+    void watchLoop();
+    void reload();
+};
+
+#endif // PROFILE_CATALOG_H
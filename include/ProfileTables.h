@@ -0,0 +1,71 @@
+#ifndef PROFILE_TABLES_H
+#define PROFILE_TABLES_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief ProfileTables class
+ *
+ * Torque, tractive force and engine power of one vehicle profile,
+ * precomputed from the VehicleCalculator formulas when the profile is
+ * loaded and read back by linear interpolation between knots every
+ * RPM_STEP. Values are stored per percent of pedal, since all of them scale
+ * linearly with the pedal level.
+ *
+ * torque() and tractiveForce() take the integer RPM of getRpm(). The torque
+ * curve is flat up to the 6000 RPM knee and linear above it, and the knee
+ * is a knot, so they are exact up to rounding.
+ *
+ * atSpeed() goes straight from road speed to traction and power: the
+ * speed is scaled to continuous RPM (no division, no getRpm) and the
+ * interpolation replaces the integer RPM staircase, which moves the result
+ * by at most one RPM's worth (see ProfileTablesBench).
+ */
+class ProfileTables {
+public:
+    static constexpr int RPM_STEP = 50;
+
+    ProfileTables(int maxRpm, int maxTorque, int wheelRadius);
+
+    static void load();                                     // rebuild for the ElectricVehicleInit profile
+    static std::shared_ptr<const ProfileTables> current();  // tables of the loaded profile
+
+    double torque(int rpm, int gasLevel) const;             // Nm, as VehicleCalculator::getTorque
+    double tractiveForce(int rpm, int gasLevel) const;      // N, as getTractiveForce(getTorque(...))
+
+    // Traction (N) and engine power (W) at a road speed in m/s
+    void atSpeed(double speed, int gasLevel, double& traction, double& power) const {
+        if (gasLevel <= 0) {
+            traction = 0.0;
+            power = 0.0;
+            return;
+        }
+        double position = std::min(std::max(speed * knotsPerSpeed, 0.0), lastKnot);
+        int index = static_cast<int>(position);
+        double fraction = position - index;
+        const Knot& knot = knots[index];
+        traction = (knot.traction + knot.tractionSlope * fraction) * gasLevel;
+        power = (knot.power + knot.powerSlope * fraction) * gasLevel;
+    }
+
+    size_t getTableBytes() const { return knots.size() * sizeof(Knot); }
+
+private:
+    // Per percent of pedal at one RPM_STEP, with the change to the next knot
+    struct Knot {
+        double torque;
+        double torqueSlope;
+        double traction;
+        double tractionSlope;
+        double power;
+        double powerSlope;
+    };
+
+    std::vector<Knot> knots;
+    double knotsPerSpeed;       // RPM per m/s / RPM_STEP
+    double lastKnot;            // position of maxRpm
+};
+
+#endif // PROFILE_TABLES_H
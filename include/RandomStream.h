@@ -0,0 +1,47 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief RandomStream class
+ *
+ * PCG32 (XSH RR) generator. Every stream number selects its own LCG
+ * increment, so streams of one seed never run into each other's sequence;
+ * giving each parallel work item its own stream makes the results
+ * independent of which thread ran it and in what order.
+ */
+class RandomStream {
+public:
+    RandomStream(uint64_t seed, uint64_t stream) : state(0), increment((stream << 1) | 1) {
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t previous = state;
+        state = previous * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((previous >> 18) ^ previous) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(previous >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    double uniform() {     // [0, 1) with 53 random bits
+        uint64_t bits = (static_cast<uint64_t>(next()) << 21) ^ (next() >> 11);
+        return static_cast<double>(bits) / 9007199254740992.0;
+    }
+
+    double normal() {      // standard normal, Box-Muller
+        double u = 1.0 - uniform();
+        double v = uniform();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+#endif // RANDOM_STREAM_H
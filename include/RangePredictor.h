@@ -0,0 +1,65 @@
+#ifndef RANGE_PREDICTOR_H
+#define RANGE_PREDICTOR_H
+
+#include "VehicleConfig.h"
+#include <vector>
+
+/**
+ * @brief RangePredictor class
+ *
+ * Remaining range from an energy-consumption map instead of the lifetime
+ * average. The map keeps the drive energy in kWh/km per SPEED_BAND_KMH
+ * speed band, seeded from the profile's road load (rolling friction and
+ * drag) and updated from the consumption observed every tick. The
+ * auxiliary load (getPowerAC + getPowerWind) is known exactly: it is split
+ * off each observation and charged back at query time for the current
+ * load, over the hours per km of recent driving, stops included.
+ *
+ * A prediction weights the bands by their share of the last PROFILE_KM,
+ * so a change from city to highway or a change of AC setting shows up
+ * within kilometres. The weighted sum is kept up to date as bands and
+ * weights change, so observe() and every query are O(1).
+ */
+class RangePredictor {
+public:
+    static constexpr int SPEED_BAND_KMH = 10;
+    static constexpr double PRIOR_KM = 0.2;           // weight of the seeded values, in km of driving
+    static constexpr double HISTORY_KM = 50.0;        // a band forgets what it saw over this distance in it
+    static constexpr double PROFILE_KM = 20.0;        // recent distance the speed profile covers
+    static constexpr double PRIOR_SPEED_KMH = 50.0;   // average speed assumed before any driving
+
+    RangePredictor(const VehicleProfile& profile);
+
+    // One tick: speed during it, distance covered, energy drawn and auxiliary power
+    void observe(double speedKmh, double distanceKm, double energyKwH, double auxPowerW, double seconds);
+
+    double consumption(double speedKmh, double auxPowerW) const;   // kWh/km of the map at a steady speed
+    double expectedConsumption(double auxPowerW) const;            // kWh/km over the recent speed profile
+    double predictRange(double remainingKwH, double auxPowerW) const;
+
+    size_t getBandCount() const { return bands.size(); }
+    double getRecentDistance() const { return recentDistance * scale; }
+
+private:
+    struct Band {
+        double seeded;      // road-load kWh/km at the band centre
+        double energy;      // observed drive kWh, fading with distance
+        double distance;    // observed km, fading the same way
+        double kwhPerKm;    // blend of seeded and observed
+        double weight;      // share of the recent distance, stored divided by scale
+    };
+
+    std::vector<Band> bands;
+    double ratedKwhPerKm;   // capacity / rated range, before any driving
+
+    // Recent speed profile; stored values times scale are the real ones, so fading is one multiply
+    double scale;
+    double recentDistance;
+    double recentHours;
+    double recentDrive;     // sum of weight * kwhPerKm
+
+    size_t bandOf(double speedKmh) const;
+    void rescale();
+};
+
+#endif // RANGE_PREDICTOR_H
@@ -6,6 +6,8 @@
 
 class SafetyManager {
 public:
+    static constexpr int MAX_PEDAL = 100;   // % of travel, brake and accelerator
+
     SafetyManager();
     ~SafetyManager();
 
@@ -23,6 +25,4 @@ private:
     int acceleratorIntensity;
 };
 
-extern bool isSafetyAction;
-
 #endif
\ No newline at end of file
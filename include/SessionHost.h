@@ -0,0 +1,53 @@
+#ifndef SESSION_HOST_H
+#define SESSION_HOST_H
+
+#include "DashboardSession.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief SessionHost class
+ *
+ * Runs many DashboardSessions on one fixed ThreadPool. tick() steps every
+ * session once with parallelFor, GRAIN sessions per claimed chunk, so a
+ * session is only ever stepped by one thread at a time. Each session
+ * persists its store at the end of its step, on the same worker, so the
+ * thread count does not grow with the number of sessions. run() ticks on a fixed
+ * period and counts the ticks that could not keep up.
+ *
+ * Sessions may be added and removed between ticks from any thread.
+ */
+class SessionHost {
+public:
+    static constexpr size_t GRAIN = 8;
+
+    SessionHost(ThreadPool* pool);
+    ~SessionHost();
+
+    DashboardSession* addSession(std::unique_ptr<DashboardSession> session);   // nullptr if its store failed to open
+    bool removeSession(int id);
+    DashboardSession* getSession(int id);       // valid until the session is removed
+    size_t getSessionCount();
+
+    void tick();                                // step every session once
+    void run(std::chrono::milliseconds period, const std::atomic<bool>& running);
+
+    uint64_t getTicks() const { return ticks.load(std::memory_order_relaxed); }
+    uint64_t getSessionTicks() const { return sessionTicks.load(std::memory_order_relaxed); }
+    uint64_t getOverruns() const { return overruns.load(std::memory_order_relaxed); }
+
+private:
+    ThreadPool* pool;
+    std::mutex sessionsMutex;       // held for a whole tick
+    std::vector<std::unique_ptr<DashboardSession>> sessions;
+
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> sessionTicks;
+    std::atomic<uint64_t> overruns;     // ticks of run() that ended after their deadline
+};
+
+#endif // SESSION_HOST_H
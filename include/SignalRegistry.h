@@ -0,0 +1,134 @@
+#ifndef SIGNAL_REGISTRY_H
+#define SIGNAL_REGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+// Every vehicle signal known to the dashboard. The order is the slot order of
+// SignalFrame and of the mapped state file.
+enum class SignalId : uint8_t {
+    VEHICLE_SPEED,
+    DRIVE_MODE,
+    BATTERY_LEVEL,
+    ROUTE_PLANNER,
+    WIND_LEVEL,
+    AC_CONTROL,
+    AC_STATUS,
+    TURN_SIGNAL,
+    BRAKE,
+    ACCELERATOR,
+    BATTERY_TEMP,
+    ODOMETER,
+    COUNT
+};
+
+enum class SignalType : uint8_t {
+    INTEGER,    // whole number, stored as CSV integer
+    REAL,       // floating point number
+    BOOL,       // "0" / "1" in CSV
+    MODE        // drive mode, 0 = "ECO", 1 = "SPORT" in CSV
+};
+
+struct SignalInfo {
+    SignalId id;
+    const char* csvName;
+    SignalType type;
+    const char* units;
+};
+
+constexpr size_t SIGNAL_COUNT = static_cast<size_t>(SignalId::COUNT);
+
+constexpr SignalInfo SIGNALS[SIGNAL_COUNT] = {
+    {SignalId::VEHICLE_SPEED, "VEHICLE_SPEED", SignalType::INTEGER, "km/h"},
+    {SignalId::DRIVE_MODE,    "DRIVE_MODE",    SignalType::MODE,    ""},
+    {SignalId::BATTERY_LEVEL, "BATTERY_LEVEL", SignalType::INTEGER, "%"},
+    {SignalId::ROUTE_PLANNER, "ROUTE_PLANNER", SignalType::INTEGER, "km"},
+    {SignalId::WIND_LEVEL,    "WIND_LEVEL",    SignalType::INTEGER, ""},
+    {SignalId::AC_CONTROL,    "AC_CONTROL",    SignalType::INTEGER, "°C"},
+    {SignalId::AC_STATUS,     "AC_STATUS",     SignalType::BOOL,    ""},
+    {SignalId::TURN_SIGNAL,   "TURN_SIGNAL",   SignalType::INTEGER, ""},
+    {SignalId::BRAKE,         "BRAKE",         SignalType::BOOL,    ""},
+    {SignalId::ACCELERATOR,   "ACCELERATOR",   SignalType::BOOL,    ""},
+    {SignalId::BATTERY_TEMP,  "BATTERY_TEMP",  SignalType::INTEGER, "°C"},
+    {SignalId::ODOMETER,      "ODOMETER",      SignalType::REAL,    "km"}
+};
+
+constexpr bool isRegistryOrdered() {
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        if (static_cast<size_t>(SIGNALS[i].id) != i) return false;
+    }
+    return true;
+}
+static_assert(isRegistryOrdered(), "SIGNALS must be listed in SignalId order");
+static_assert(SIGNAL_COUNT <= 32, "SignalFrame uses a 32-bit presence mask");
+
+constexpr size_t signalIndex(SignalId id) { return static_cast<size_t>(id); }
+constexpr const SignalInfo& signalInfo(SignalId id) { return SIGNALS[signalIndex(id)]; }
+constexpr uint32_t signalBit(SignalId id) { return 1u << signalIndex(id); }
+
+// Drive mode values of the MODE signal
+constexpr double DRIVE_MODE_ECO = 0.0;
+constexpr double DRIVE_MODE_SPORT = 1.0;
+
+// Typed values of all signals, indexed by SignalId
+struct SignalFrame {
+    std::array<double, SIGNAL_COUNT> values{};
+    uint32_t presentMask = 0;
+
+    bool has(SignalId id) const { return presentMask & signalBit(id); }
+    double get(SignalId id) const { return values[signalIndex(id)]; }
+    int getInt(SignalId id) const { return static_cast<int>(get(id)); }
+    bool getBool(SignalId id) const { return get(id) != 0.0; }
+    void set(SignalId id, double value) {
+        values[signalIndex(id)] = value;
+        presentMask |= signalBit(id);
+    }
+};
+
+struct SignalUpdate {
+    SignalId id;
+    double value;
+};
+
+// Up to one update per signal, built on the stack by the hot paths
+class SignalBatch {
+public:
+    SignalBatch() = default;
+    SignalBatch(std::initializer_list<SignalUpdate> list) {
+        for (const auto& update : list) set(update.id, update.value);
+    }
+
+    void set(SignalId id, double value) {
+        for (size_t i = 0; i < count; i++) {
+            if (updates[i].id == id) {
+                updates[i].value = value;
+                return;
+            }
+        }
+        updates[count++] = {id, value};
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    const SignalUpdate* begin() const { return updates.data(); }
+    const SignalUpdate* end() const { return updates.data() + count; }
+
+private:
+    std::array<SignalUpdate, SIGNAL_COUNT> updates{};
+    size_t count = 0;
+};
+
+// Conversions used only at the persistence boundary
+constexpr size_t SIGNAL_TEXT_MAX = 32;     // longest text formatSignal() produces
+
+bool findSignal(std::string_view csvName, SignalId& id);
+bool parseSignal(SignalId id, std::string_view text, double& value);
+size_t formatSignal(SignalId id, double value, char* out);     // writes up to SIGNAL_TEXT_MAX chars
+std::string formatSignal(SignalId id, double value);
+const char* driveModeName(double mode);
+
+#endif // SIGNAL_REGISTRY_H
@@ -0,0 +1,252 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// VehicleCalculator constants, copied once by VehicleKernels
+struct KernelConstants {
+    double pi;
+    double finalGearRatio;      // GR
+    double gearRatio;           // GEAR_RATIO
+    double efficiencyDrive;
+    double gravity;
+    double staticFriction;      // US
+    double rollingFriction;     // CR
+    double brakeFriction;       // UK
+    double dragFactor;          // 0.5 * CD * AIR_DENSITY * AREA
+    double coolingBase;
+    double coolingRate;
+    double heatAlpha;
+    double heatBeta;
+};
+
+// One implementation of every batch kernel, filled in per instruction set
+struct KernelTable {
+    void (*rpm)(const KernelConstants&, const double* speed, size_t count, int wheelRadius, int maxRpm, double* out);
+    void (*torque)(const KernelConstants&, const double* rpm, const int32_t* gasLevel, size_t count, int maxRpm,
+                   int maxTorque, double* out);
+    void (*tractiveForce)(const KernelConstants&, const double* torque, size_t count, int wheelRadius, double* out);
+    void (*enginePower)(const KernelConstants&, const double* torque, const double* rpm, size_t count, double* out);
+    void (*airDragForce)(const KernelConstants&, const double* speed, size_t count, double* out);
+    void (*acceleration)(const KernelConstants&, const double* speed, const double* traction,
+                         const int32_t* brakeLevel, size_t count, int weight, double* lastAcceleration, double* out);
+    void (*batteryTemp)(const KernelConstants&, double* batteryTemp, const double* enginePower, size_t count,
+                        double envTemp);
+    void (*cellTemp)(const KernelConstants&, const double* temp, const double* heat, const double* cooling, size_t count,
+                     size_t stride, double heatScale, double conduction, double coolingScale, double coolantTemp,
+                     double* out);
+};
+
+const KernelTable* getSse2Kernels();    // nullptr when not built for this target
+const KernelTable* getAvx2Kernels();
+
+/**
+ * @brief SimdKernels class
+ *
+ * The vector bodies of the batch kernels, written once against an `Ops`
+ * wrapper (V, WIDTH, load/store, arithmetic, compares returning masks,
+ * select) and instantiated by each instruction-set translation unit. The
+ * last count % WIDTH elements go through a zero-padded vector. Every
+ * operation mirrors the order of the scalar VehicleCalculator formula.
+ */
+template <typename Ops>
+class SimdKernels {
+    using V = typename Ops::V;
+    static constexpr size_t W = Ops::WIDTH;
+
+    static V loadTail(const double* p, size_t n) {
+        double lane[W] = {};
+        for (size_t j = 0; j < n; j++) lane[j] = p[j];
+        return Ops::load(lane);
+    }
+    static V loadIntTail(const int32_t* p, size_t n) {
+        int32_t lane[W] = {};
+        for (size_t j = 0; j < n; j++) lane[j] = p[j];
+        return Ops::loadInt(lane);
+    }
+    static void storeTail(double* p, V v, size_t n) {
+        double lane[W];
+        Ops::store(lane, v);
+        for (size_t j = 0; j < n; j++) p[j] = lane[j];
+    }
+
+    static V rpmOf(const KernelConstants& k, V speed, double denominator, double maxRpm) {
+        V rpm = Ops::div(Ops::mul(Ops::mul(speed, Ops::set1(k.finalGearRatio)), Ops::set1(60.0)), Ops::set1(denominator));
+        rpm = Ops::max(Ops::min(rpm, Ops::set1(maxRpm)), Ops::zero());
+        return Ops::truncate(rpm);
+    }
+
+    static V torqueOf(V rpm, V gas, double maxRpm, double maxTorque) {
+        const double RPM_THRESHOLD = 6000.0;
+        V falloff = Ops::div(Ops::sub(rpm, Ops::set1(RPM_THRESHOLD)), Ops::set1(maxRpm - RPM_THRESHOLD));
+        V reduced = Ops::max(Ops::mul(Ops::set1(maxTorque), Ops::sub(Ops::set1(1.0), falloff)), Ops::zero());
+        V torque = Ops::select(Ops::lt(rpm, Ops::set1(RPM_THRESHOLD)), Ops::set1(maxTorque), reduced);
+        V result = Ops::div(Ops::mul(torque, gas), Ops::set1(100.0));
+        return Ops::select(Ops::le(gas, Ops::zero()), Ops::zero(), result);
+    }
+
+    static V tractionOf(const KernelConstants& k, V torque, double wheelRadiusMeters) {
+        V traction = Ops::mul(Ops::mul(Ops::mul(torque, Ops::set1(k.gearRatio)), Ops::set1(k.efficiencyDrive)),
+                              Ops::set1(100.0));
+        return Ops::div(traction, Ops::set1(wheelRadiusMeters));
+    }
+
+    static V powerOf(const KernelConstants& k, V torque, V rpm) {
+        V angularSpeed = Ops::div(Ops::mul(Ops::mul(rpm, Ops::set1(2.0)), Ops::set1(k.pi)), Ops::set1(60.0));
+        return Ops::div(Ops::mul(torque, angularSpeed), Ops::set1(k.efficiencyDrive));
+    }
+
+    static V dragOf(const KernelConstants& k, V speed) {
+        return Ops::mul(Ops::set1(k.dragFactor), Ops::mul(speed, speed));
+    }
+
+    static V accelerationOf(const KernelConstants& k, V speed, V traction, V brake, V& last, int weight) {
+        const double MIN_ACCELERATION = 0.2;
+        const double EPSILON = 0.01;
+        V zero = Ops::zero();
+
+        // Starting from standstill the forces are evaluated at zero speed
+        auto standing = Ops::lt(speed, Ops::set1(EPSILON));
+        V v = Ops::select(standing, zero, speed);
+
+        V maxBrake = Ops::select(Ops::gt(v, zero), Ops::set1(k.brakeFriction * 1.5 * weight * k.gravity), zero);
+        V multiplier = Ops::add(Ops::set1(1.0), Ops::div(brake, Ops::set1(100.0)));
+        V brakeForce = Ops::div(Ops::mul(Ops::mul(brake, maxBrake), multiplier), Ops::set1(100.0));
+        V resistance = Ops::add(Ops::add(Ops::set1(k.rollingFriction * weight * k.gravity), dragOf(k, v)), brakeForce);
+        V acceleration = Ops::div(Ops::sub(traction, resistance), Ops::set1(static_cast<double>(weight)));
+
+        auto pulling = Ops::gt(traction, zero);
+        acceleration = Ops::select(Ops::bitAnd(Ops::lt(acceleration, Ops::set1(MIN_ACCELERATION)), pulling),
+                                   Ops::set1(MIN_ACCELERATION), acceleration);
+
+        // Pedal held but forces losing: decay the previous acceleration
+        V decayed = Ops::mul(last, Ops::set1(0.9));
+        decayed = Ops::select(Ops::lt(decayed, Ops::set1(0.01)), zero, decayed);
+        auto coasting = Ops::bitAnd(Ops::bitAnd(pulling, Ops::eq(brake, zero)), Ops::lt(acceleration, zero));
+        acceleration = Ops::select(Ops::bitAndNot(standing, coasting), decayed, acceleration);
+
+        // Not enough traction to overcome static friction
+        auto stuck = Ops::bitAnd(standing, Ops::lt(traction, Ops::set1(k.staticFriction * weight * k.gravity)));
+        acceleration = Ops::select(stuck, zero, acceleration);
+        last = acceleration;
+        return acceleration;
+    }
+
+    static V batteryTempOf(const KernelConstants& k, V previous, V power, double envTemp) {
+        V env = Ops::set1(envTemp);
+        V cooling = Ops::add(Ops::set1(k.coolingBase), Ops::mul(Ops::set1(k.coolingRate), Ops::sub(previous, env)));
+        cooling = Ops::div(cooling, Ops::set1(1000.0));
+        V powerK = Ops::div(power, Ops::set1(1000.0));
+        return Ops::sub(Ops::add(env, Ops::mul(Ops::set1(k.heatAlpha), powerK)), Ops::mul(Ops::set1(k.heatBeta), cooling));
+    }
+
+    static V cellTempOf(V temp, V left, V right, V up, V down, V heat, V cooling, double heatScale, double conduction,
+                        double coolingScale, double coolantTemp) {
+        V neighbours = Ops::add(Ops::add(left, right), Ops::add(up, down));
+        V laplacian = Ops::sub(neighbours, Ops::mul(Ops::set1(4.0), temp));
+        V heated = Ops::add(Ops::add(temp, Ops::mul(Ops::set1(heatScale), heat)), Ops::mul(Ops::set1(conduction), laplacian));
+        V cooled = Ops::mul(Ops::mul(Ops::set1(coolingScale), cooling), Ops::sub(temp, Ops::set1(coolantTemp)));
+        return Ops::sub(heated, cooled);
+    }
+
+public:
+    static void rpm(const KernelConstants& k, const double* speed, size_t count, int wheelRadius, int maxRpm, double* out) {
+        double denominator = 2.0 * k.pi * (wheelRadius / 100.0);
+        size_t i = 0;
+        for (; i + W <= count; i += W) Ops::store(out + i, rpmOf(k, Ops::load(speed + i), denominator, maxRpm));
+        if (i < count) storeTail(out + i, rpmOf(k, loadTail(speed + i, count - i), denominator, maxRpm), count - i);
+    }
+
+    static void torque(const KernelConstants&, const double* rpm, const int32_t* gasLevel, size_t count, int maxRpm,
+                       int maxTorque, double* out) {
+        size_t i = 0;
+        for (; i + W <= count; i += W) {
+            Ops::store(out + i, torqueOf(Ops::load(rpm + i), Ops::loadInt(gasLevel + i), maxRpm, maxTorque));
+        }
+        if (i < count) {
+            V result = torqueOf(loadTail(rpm + i, count - i), loadIntTail(gasLevel + i, count - i), maxRpm, maxTorque);
+            storeTail(out + i, result, count - i);
+        }
+    }
+
+    static void tractiveForce(const KernelConstants& k, const double* torque, size_t count, int wheelRadius, double* out) {
+        double wheelRadiusMeters = wheelRadius / 100.0;
+        size_t i = 0;
+        for (; i + W <= count; i += W) Ops::store(out + i, tractionOf(k, Ops::load(torque + i), wheelRadiusMeters));
+        if (i < count) storeTail(out + i, tractionOf(k, loadTail(torque + i, count - i), wheelRadiusMeters), count - i);
+    }
+
+    static void enginePower(const KernelConstants& k, const double* torque, const double* rpm, size_t count, double* out) {
+        size_t i = 0;
+        for (; i + W <= count; i += W) Ops::store(out + i, powerOf(k, Ops::load(torque + i), Ops::load(rpm + i)));
+        if (i < count) {
+            storeTail(out + i, powerOf(k, loadTail(torque + i, count - i), loadTail(rpm + i, count - i)), count - i);
+        }
+    }
+
+    static void airDragForce(const KernelConstants& k, const double* speed, size_t count, double* out) {
+        size_t i = 0;
+        for (; i + W <= count; i += W) Ops::store(out + i, dragOf(k, Ops::load(speed + i)));
+        if (i < count) storeTail(out + i, dragOf(k, loadTail(speed + i, count - i)), count - i);
+    }
+
+    static void acceleration(const KernelConstants& k, const double* speed, const double* traction,
+                             const int32_t* brakeLevel, size_t count, int weight, double* lastAcceleration, double* out) {
+        size_t i = 0;
+        for (; i + W <= count; i += W) {
+            V last = Ops::load(lastAcceleration + i);
+            V result = accelerationOf(k, Ops::load(speed + i), Ops::load(traction + i), Ops::loadInt(brakeLevel + i),
+                                      last, weight);
+            Ops::store(out + i, result);
+            Ops::store(lastAcceleration + i, last);
+        }
+        if (i < count) {
+            size_t n = count - i;
+            V last = loadTail(lastAcceleration + i, n);
+            V result = accelerationOf(k, loadTail(speed + i, n), loadTail(traction + i, n), loadIntTail(brakeLevel + i, n),
+                                      last, weight);
+            storeTail(out + i, result, n);
+            storeTail(lastAcceleration + i, last, n);
+        }
+    }
+
+    static void batteryTemp(const KernelConstants& k, double* batteryTemp, const double* enginePower, size_t count,
+                            double envTemp) {
+        size_t i = 0;
+        for (; i + W <= count; i += W) {
+            Ops::store(batteryTemp + i, batteryTempOf(k, Ops::load(batteryTemp + i), Ops::load(enginePower + i), envTemp));
+        }
+        if (i < count) {
+            size_t n = count - i;
+            storeTail(batteryTemp + i, batteryTempOf(k, loadTail(batteryTemp + i, n), loadTail(enginePower + i, n), envTemp), n);
+        }
+    }
+
+    static void cellTemp(const KernelConstants&, const double* temp, const double* heat, const double* cooling, size_t count,
+                         size_t stride, double heatScale, double conduction, double coolingScale, double coolantTemp,
+                         double* out) {
+        const double* up = temp - stride;
+        const double* down = temp + stride;
+        size_t i = 0;
+        for (; i + W <= count; i += W) {
+            Ops::store(out + i, cellTempOf(Ops::load(temp + i), Ops::load(temp + i - 1), Ops::load(temp + i + 1),
+                                           Ops::load(up + i), Ops::load(down + i), Ops::load(heat + i),
+                                           Ops::load(cooling + i), heatScale, conduction, coolingScale, coolantTemp));
+        }
+        if (i < count) {
+            size_t n = count - i;
+            storeTail(out + i, cellTempOf(loadTail(temp + i, n), loadTail(temp + i - 1, n), loadTail(temp + i + 1, n),
+                                          loadTail(up + i, n), loadTail(down + i, n), loadTail(heat + i, n),
+                                          loadTail(cooling + i, n), heatScale, conduction, coolingScale, coolantTemp), n);
+        }
+    }
+
+    static const KernelTable* table() {
+        static const KernelTable kernels = {rpm, torque, tractiveForce, enginePower, airDragForce, acceleration, batteryTemp,
+                                            cellTemp};
+        return &kernels;
+    }
+};
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,59 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief SimulationClock class
+ *
+ * The time base of the vehicle physics. The owner starts every tick with
+ * tick() (or advance() for a given step), and every component then
+ * integrates over the same getDeltaTime(), so speed and battery never see
+ * different steps for one tick.
+ *
+ *  - REAL_TIME:   the step is the wall time since the previous tick
+ *  - FIXED_STEP:  every tick is fixedStep seconds, whatever the wall time
+ *  - ACCELERATED: the wall time since the previous tick times timeScale
+ *
+ * Measured steps are clamped to [MIN_STEP, MAX_STEP] before scaling, so a
+ * stalled process does not integrate a huge jump. advance() only enforces
+ * MIN_STEP, so a replay integrates the steps an ACCELERATED run recorded.
+ */
+class SimulationClock {
+public:
+    enum class Mode {
+        REAL_TIME,
+        FIXED_STEP,
+        ACCELERATED
+    };
+
+    static constexpr double MIN_STEP = 0.001;       // s
+    static constexpr double MAX_STEP = 1.0;         // s
+    static constexpr double DEFAULT_STEP = 0.06;    // s, one dashboard loop
+
+    SimulationClock(Mode mode = Mode::REAL_TIME, double fixedStep = DEFAULT_STEP, double timeScale = 1.0);
+
+    double tick();                      // start the next tick, returns its step in seconds
+    void advance(double deltaTime);     // start the next tick with an explicit step (replays)
+
+    double getDeltaTime() const { return deltaTime; }
+    double getTime() const { return simulatedTime; }    // simulated seconds since construction
+    uint64_t getTicks() const { return ticks; }
+    Mode getMode() const { return mode; }
+    double getTimeScale() const { return timeScale; }
+
+private:
+    Mode mode;
+    double fixedStep;
+    double timeScale;
+    double deltaTime;
+    double simulatedTime;
+    uint64_t ticks;
+    std::chrono::steady_clock::time_point previousTick;
+    bool hasPreviousTick;
+
+    static double clampStep(double step);
+};
+
+#endif // SIMULATION_CLOCK_H
@@ -4,29 +4,80 @@
 #include "VehicleConfig.h"
 #include "DriveMode.h"
 #include "SafetyManager.h"
-#include <chrono>
+#include "SimulationClock.h"
+#include "ProfileTables.h"
+#include "Integrator.h"
+#include <memory>
+#include <string>
+
+// Acceleration within one tick as a function of speed, the pedal levels, drive mode and limits held
+struct LongitudinalModel {
+    const ProfileTables* tables = nullptr;
+    int weight = 0;             // kg, load included
+    int gasLevel = 0;           // %
+    int brakeLevel = 0;         // %
+    bool accelerating = false;  // accelerator pressed: the mode factor scales the gain and speed does not drop
+    double modeFactor = 1.0;    // DriveModeFactor of the current mode
+    double maxSpeed = 0.0;      // m/s
+
+    double operator()(double speed) const {
+        double traction, power;
+        tables->atSpeed(speed, gasLevel, traction, power);
+        // The coasting fallback needs traction below the minimum acceleration, which cannot happen, so no history
+        double lastAcceleration = 0.0;
+        double acceleration = VehicleCalculator::getAcceleration(speed, traction, weight, brakeLevel, lastAcceleration);
+        if (accelerating) acceleration = acceleration > 0.0 ? acceleration * modeFactor : 0.0;
+        if (speed >= maxSpeed && acceleration > 0.0) acceleration = 0.0;
+        if (speed <= 0.0 && acceleration < 0.0) acceleration = 0.0;
+        return acceleration;
+    }
+};
 
 class SpeedCalculator {
 public:
-    SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager);
+    static constexpr int LOAD = 200;    // kg on top of the vehicle weight, suppose max load of car is 200kg
+
+    SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager, SimulationClock* clock);   // the ElectricVehicleInit profile
+    SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager, SimulationClock* clock,
+                    const VehicleProfile& profile);
     ~SpeedCalculator();
 
-    int calculateSpeed(bool isAcceleratorPressed, bool isBrakePressed);
+    int calculateSpeed(bool isAcceleratorPressed, bool isBrakePressed);    // step by the clock's current tick
     
     double getTotalDistance() const {return totalDistance;}
     double getPowerConsumption() const {return powerConsumption;}
     int getCurrentSpeed() const {return currentSpeed;}
     int getMaxSpeed(const std::string& driveMode) const;
+    void restoreDistance(double distanceKm); // resume the odometer after a restart
+    void setProfile(const VehicleProfile& profile);  // limits, weight and tables of another profile, speed kept
+
+    // EULER keeps the original int km/h step; the others integrate a continuous speed and position
+    void setIntegrator(IntegratorMethod method, double tolerance = Integrator::DEFAULT_TOLERANCE);
+    const Integrator& getIntegrator() const { return integrator; }
+    double getSpeedMetersPerSecond() const { return motion.speed; }
 
 private:
     DriveMode* driveMode;
     SafetyManager* safetyManager;
+    SimulationClock* clock;
     double totalDistance;
+    double distanceInMeters;
     double powerConsumption;
     int currentSpeed;
     int maxSpeedEco;
     int maxSpeedSport;
+    int totalWeight;
+    std::shared_ptr<const ProfileTables> tables;
+    Integrator integrator;
+    MotionState motion;
+
+    // Per-vehicle history between steps
+    int lastSpeed;
+    std::string lastDriveMode;
+    std::string previousMode;
+    double lastAcceleration;
 
+    int integrateSpeed(bool isAcceleratorPressed, bool isBrakePressed);
     void adjustSpeed(bool isAcceleratorPressed, bool isBrakePressed);
     void adjustSpeedForDriveMode(const std::string& driveMode);
 };
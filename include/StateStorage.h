@@ -0,0 +1,70 @@
+#ifndef STATE_STORAGE_H
+#define STATE_STORAGE_H
+
+#include <string>
+#include <unordered_map>
+#include "SignalRegistry.h"
+#include "CsvCodec.h"
+
+using CSVMap = std::unordered_map<std::string, std::string>;
+
+enum class StorageBackend {
+    CSV,        // key,value text file rewritten by the write-behind flusher
+    MAPPED,     // memory-mapped fixed-slot binary file, one store per update
+    JOURNAL     // append-only journal compacted into the CSV snapshot
+};
+
+/**
+ * @brief StateStorage interface
+ *
+ * Persistence backend behind DataHandler. Write-behind backends receive the
+ * whole state from the writer thread; write-through backends receive every
+ * coalesced batch of key writes as it is drained.
+ */
+class StateStorage {
+public:
+    virtual ~StateStorage() = default;
+
+    virtual CSVMap load() = 0;                          // read the persisted state
+    virtual bool persist(const CSVMap& data) = 0;       // persist a full snapshot
+    virtual bool isWriteThrough() const { return false; }
+    virtual bool store(const std::string& /*key*/, const std::string& /*value*/) { return false; }
+    virtual bool storeSignal(SignalId id, double value) {
+        return store(signalInfo(id).csvName, formatSignal(id, value));
+    }
+    virtual bool storeBatch(const SignalBatch& batch) {         // write-through several signals at once
+        bool stored = true;
+        for (const auto& update : batch) {
+            stored = storeSignal(update.id, update.value) && stored;
+        }
+        return stored;
+    }
+    virtual bool loadFrame(SignalFrame& frame, CSVMap& extras);             // load() split by the registry
+    virtual bool persistFrame(const SignalFrame& frame, const CSVMap& extras); // persist() without text keys
+    virtual void sync() {}                              // make write-through data durable
+    virtual void maintain() {}                          // background work of a store without its own threads
+    virtual bool supportsExternalWriters() const { return true; }
+    virtual bool pollsExternalWriters() const { return false; }     // writes raise no inotify event
+    virtual bool hasExternalChange() { return false; }              // polled under DataHandler's file lock
+    virtual bool hasRecoveredState() const { return false; }    // state survived a previous run
+    virtual std::string getPath() const = 0;
+};
+
+// Reads and writes the "key,value" CSV file through reused buffers
+class CsvStorage : public StateStorage {
+public:
+    CsvStorage(const std::string& filename);
+
+    CSVMap load() override;
+    bool persist(const CSVMap& data) override;
+    bool loadFrame(SignalFrame& frame, CSVMap& extras) override;
+    bool persistFrame(const SignalFrame& frame, const CSVMap& extras) override;
+    std::string getPath() const override { return filename; }
+
+private:
+    std::string filename;
+    std::string readBuffer;
+    CsvWriter writer;
+};
+
+#endif // STATE_STORAGE_H
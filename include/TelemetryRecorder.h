@@ -0,0 +1,162 @@
+#ifndef TELEMETRY_RECORDER_H
+#define TELEMETRY_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpscQueue.h"
+#include "VehicleState.h"
+
+constexpr char TELEMETRY_MAGIC[8] = {'C', 'A', 'R', 'T', 'R', 'I', 'P', '\0'};
+constexpr uint32_t TELEMETRY_VERSION = 1;
+
+// Driver controls packed into TelemetrySample::inputFlags
+constexpr uint32_t TELEMETRY_ACCELERATOR = 1u << 0;
+constexpr uint32_t TELEMETRY_BRAKE       = 1u << 1;
+constexpr uint32_t TELEMETRY_SPORT       = 1u << 2;
+constexpr uint32_t TELEMETRY_AC_ON       = 1u << 3;
+constexpr uint32_t TELEMETRY_TURN_LEFT   = 1u << 4;
+constexpr uint32_t TELEMETRY_TURN_RIGHT  = 1u << 5;
+
+// One mainLoop tick
+struct TelemetrySample {
+    int64_t timestampMicros = 0;    // trip start (wall clock, us since the epoch) plus simulated time in us
+    int speed = 0;                  // km/h
+    int gasIntensity = 0;           // %
+    int brakeIntensity = 0;         // %
+    uint32_t inputFlags = 0;        // TELEMETRY_* bits
+    int acTemp = 0;                 // °C
+    int windLevel = 0;
+    double powerConsumption = 0.0;  // W
+    double currentKwH = 0.0;        // kWh left in the battery
+    double batteryTemp = 0.0;       // °C
+    double odometer = 0.0;          // km
+};
+
+// Column order on disk; the first TELEMETRY_INT_COLUMNS columns are integers
+enum class TelemetryColumn : uint8_t {
+    TIMESTAMP, SPEED, GAS, BRAKE, INPUTS, AC_TEMP, WIND,
+    POWER, KWH, BATTERY_TEMP, ODOMETER,
+    COUNT
+};
+constexpr size_t TELEMETRY_COLUMNS = static_cast<size_t>(TelemetryColumn::COUNT);
+constexpr size_t TELEMETRY_INT_COLUMNS = static_cast<size_t>(TelemetryColumn::POWER);
+constexpr size_t TELEMETRY_RAW_SAMPLE_BYTES = 8 + 6 * 4 + 4 * 8;   // native width of every field
+
+enum class TelemetryEncoding : uint8_t {
+    DELTA = 1,              // zigzag varint of the difference to the previous value
+    DELTA_OF_DELTA = 2,     // zigzag varint of the change in the difference (timestamps)
+    XOR = 3                 // Gorilla XOR of the IEEE-754 bits (doubles)
+};
+
+uint32_t packInputFlags(const DriverInputs& inputs);
+DriverInputs unpackInputFlags(uint32_t flags, int acTemp, int windLevel);
+
+struct TelemetryStats {
+    uint64_t samplesRecorded = 0;   // accepted by record()
+    uint64_t samplesDropped = 0;    // rejected because the queue was full
+    uint64_t samplesWritten = 0;
+    uint64_t blocksWritten = 0;
+    uint64_t rawBytes = 0;          // samplesWritten * TELEMETRY_RAW_SAMPLE_BYTES
+    uint64_t encodedBytes = 0;      // bytes appended to the file, headers included
+    double encodeMs = 0.0;          // time spent compressing
+    double writeMs = 0.0;           // time spent in write()
+
+    double compressionRatio() const { return encodedBytes ? static_cast<double>(rawBytes) / encodedBytes : 0.0; }
+};
+
+/**
+ * @brief TelemetryRecorder class
+ *
+ * Append-only columnar trip log. record() copies a sample into a lock-free
+ * queue and returns; a background thread collects up to BLOCK_SAMPLES
+ * samples, encodes each column (delta varints for integers, Gorilla XOR
+ * for doubles) and appends the block with one write():
+ *
+ *     file  : [magic 8][version 4][column count 4][start micros 8] block*
+ *     block : [sample count 4][payload bytes 4][crc32 of payload 4] payload
+ *     payload: per column [encoding 1][bytes 4][encoded column]
+ *
+ * start micros is the wall clock when the log was opened, in microseconds
+ * since the epoch. Sample timestamps are not wall clock: the recording
+ * program sets them to its own start time plus the simulated time, so
+ * TripReplay can recover the simulated step between samples.
+ *
+ * A partial block is written every FLUSH_INTERVAL_MS, so a crash loses at
+ * most that much of the trip.
+ */
+class TelemetryRecorder {
+public:
+    static constexpr size_t BLOCK_SAMPLES = 1024;
+    static constexpr int FLUSH_INTERVAL_MS = 1000;
+
+    TelemetryRecorder(const std::string& path);
+    ~TelemetryRecorder();
+
+    bool isOpen() const { return fd != -1; }
+    bool record(const TelemetrySample& sample);     // never blocks, false if the sample was dropped
+    void close();                                   // write the remaining samples and stop
+    TelemetryStats getStats();
+    const std::string& getPath() const { return path; }
+
+private:
+    static constexpr size_t QUEUE_CAPACITY = 8192;
+
+    std::string path;
+    int fd;
+
+    MpscQueue<TelemetrySample, QUEUE_CAPACITY> queue;
+    std::thread writer;
+    std::mutex writerMutex;
+    std::condition_variable writerCv;
+    std::atomic<bool> writerIdle;
+    bool stopWriter;
+
+    // Owned by the writer thread
+    std::vector<TelemetrySample> block;
+    std::vector<uint8_t> encoded;
+    std::vector<int64_t> intColumn;
+    std::vector<double> realColumn;
+
+    std::atomic<uint64_t> samplesRecorded;
+    std::atomic<uint64_t> samplesDropped;
+    std::mutex statsMutex;
+    TelemetryStats writerStats;     // guarded by statsMutex
+
+    void writerLoop();
+    bool writeBlock();
+};
+
+/**
+ * @brief TelemetryReader class
+ *
+ * Decodes a file written by TelemetryRecorder block by block. Reading
+ * stops at the first torn or corrupt block, which is what a crash leaves
+ * behind.
+ */
+class TelemetryReader {
+public:
+    TelemetryReader(const std::string& path);
+    ~TelemetryReader();
+
+    bool isOpen() const { return fd != -1; }
+    int64_t getStartMicros() const { return startMicros; }     // wall clock when the log was opened, us since the epoch
+    bool nextBlock(std::vector<TelemetrySample>& samples);   // false at the end of the log
+    bool readAll(std::vector<TelemetrySample>& samples);
+    bool isTruncated() const { return truncated; }           // the log ended in a torn block
+
+private:
+    int fd;
+    int64_t startMicros;
+    bool truncated;
+    std::vector<uint8_t> payload;
+    std::vector<int64_t> intColumn;
+    std::vector<double> realColumn;
+};
+
+#endif // TELEMETRY_RECORDER_H
@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief ThreadPool class
+ *
+ * Fixed set of worker threads for data-parallel loops. parallelFor() splits
+ * [0, count) into chunks of `grain` items; the workers and the calling
+ * thread claim chunks from a shared atomic counter until none are left, and
+ * the call returns when every chunk is done. A pool of one thread runs the
+ * loop inline on the caller.
+ */
+class ThreadPool {
+public:
+    ThreadPool(size_t threadCount);     // total threads, the caller included
+    ~ThreadPool();
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& body);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    uint64_t generation;        // bumped for every parallelFor, guarded by mutex
+    size_t busyWorkers;         // guarded by mutex
+    bool stopping;
+
+    // The loop being run, published under mutex with generation
+    const std::function<void(size_t, size_t)>* body;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> nextChunk;
+
+    void workerLoop();
+    void runChunks();
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,42 @@
+#ifndef TRIP_REPLAY_H
+#define TRIP_REPLAY_H
+
+#include <cstdint>
+#include <vector>
+#include "Integrator.h"
+#include "TelemetryRecorder.h"
+#include "VehicleState.h"
+
+struct ReplayResult {
+    uint64_t ticks = 0;
+    double simulatedSeconds = 0.0;  // simulation clock time at the end
+    double wallSeconds = 0.0;       // time the replay took
+    uint64_t outputHash = 0;        // FNV-1a of every tick's outputs, equal for identical runs
+    VehicleState finalState;
+    double finalKwH = 0.0;
+
+    double speedup() const { return wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0; }
+};
+
+/**
+ * @brief TripReplay class
+ *
+ * Feeds the driver inputs of a recorded trip back through the vehicle
+ * physics as fast as the CPU allows. Each tick advances the simulation
+ * clock by the recorded time between samples instead of the wall clock, so
+ * the same trip always produces bit-identical outputs, whichever
+ * integrator is selected. The vehicle profile must be set up with
+ * ElectricVehicleInit before run().
+ */
+class TripReplay {
+public:
+    TripReplay(const std::vector<TelemetrySample>& samples, IntegratorMethod integrator = IntegratorMethod::EULER);
+
+    ReplayResult run() const;   // fresh vehicle for every run
+
+private:
+    const std::vector<TelemetrySample>& samples;
+    IntegratorMethod integrator;
+};
+
+#endif // TRIP_REPLAY_H
@@ -1,13 +1,22 @@
 #ifndef VEHICLE_CONFIG_H
 #define VEHICLE_CONFIG_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <memory>
 #include <string>
-#include <map>
+#include <utility>
 
 bool strToBool(const std::string& str);
 
 class VehicleCalculator {
+    friend class VehicleKernels;    // batch versions share the constants
+    friend class ProfileTables;     // so do the lookup tables
+    friend class RangePredictor;    // and the seeded energy map
+
 private:
     static constexpr int GEAR_RATIO = 9; // Gear ratio
     static constexpr double PI = 3.14159;
@@ -65,10 +74,11 @@ public:
         return fTractive;
     }
 
-    static double getAcceleration(const double& speed, const double& fTractive, const int& weight, const int& brakeLevel) {
+    // lastAcceleration carries the previous result of the same vehicle between calls
+    static double getAcceleration(const double& speed, const double& fTractive, const int& weight, const int& brakeLevel,
+                                  double& lastAcceleration) {
         const double MIN_ACCELERATION = 0.2; 
         const double EPSILON = 0.01; 
-        static double lastAcceleration = 0.0; 
         
         // Special case for starting from zero speed
         if (speed < EPSILON) { 
@@ -225,8 +235,164 @@ enum class VehicleAttribute {
     WIND_LEVEL_MAX
 };
 
+const char* attributeName(VehicleAttribute attribute);                      // "BATTERY_CAPACITY", ...
+bool parseAttribute(const std::string& name, VehicleAttribute& attribute);  // false if no attribute has that name
+
 using designValue = int16_t;
-using vehicleBaseParam = std::map<VehicleAttribute, designValue>;
+
+constexpr size_t VEHICLE_ATTRIBUTE_COUNT = static_cast<size_t>(VehicleAttribute::WIND_LEVEL_MAX) + 1;
+
+/**
+ * @brief DesignValues struct
+ *
+ * One design value per VehicleAttribute in an array indexed by the
+ * attribute, so a lookup is a single load. Built from {attribute, value}
+ * pairs like the maps it replaces; isComplete() tells whether every
+ * attribute was given, and static_asserts on the built-in models use it.
+ */
+struct DesignValues {
+    std::array<designValue, VEHICLE_ATTRIBUTE_COUNT> values{};
+    uint32_t setMask = 0;   // bit per attribute given a value
+
+    constexpr DesignValues() = default;
+    constexpr DesignValues(std::initializer_list<std::pair<VehicleAttribute, designValue>> entries) {
+        for (const auto& entry : entries) {
+            set(entry.first, entry.second);
+        }
+    }
+
+    constexpr designValue operator[](VehicleAttribute attribute) const { return values[index(attribute)]; }
+    constexpr void set(VehicleAttribute attribute, designValue value) {
+        values[index(attribute)] = value;
+        setMask |= 1u << index(attribute);
+    }
+    // An attribute left unset differs from one set to 0
+    constexpr bool operator==(const DesignValues& other) const {
+        if (setMask != other.setMask) return false;
+        for (size_t i = 0; i < VEHICLE_ATTRIBUTE_COUNT; i++) {
+            if (values[i] != other.values[i]) return false;
+        }
+        return true;
+    }
+    constexpr bool isComplete() const { return setMask == (1u << VEHICLE_ATTRIBUTE_COUNT) - 1; }
+
+    static constexpr size_t index(VehicleAttribute attribute) { return static_cast<size_t>(attribute); }
+};
+
+using vehicleBaseParam = DesignValues;
+
+// Built-in models, checked at compile time
+inline constexpr vehicleBaseParam TESLA_MODEL3_STANDARD = {
+    {VehicleAttribute::BATTERY_CAPACITY,54},
+    {VehicleAttribute::BATTERY_VOLTAGE,350},
+    {VehicleAttribute::MAX_RANGE,409},
+    {VehicleAttribute::MAX_TORQUE,300},
+    {VehicleAttribute::MAX_AC_POWER,2500},
+    {VehicleAttribute::MAX_ENGINE_POWER,211},
+    {VehicleAttribute::MAX_SPEED_SPORT,225},
+    {VehicleAttribute::MAX_SPEED_ECO,160},
+    {VehicleAttribute::MAX_RPM,16000},
+    {VehicleAttribute::WEIGHT,1612},
+    {VehicleAttribute::WHEEL_RADIUS,34},
+    {VehicleAttribute::AC_TEMP_MAX,28},
+    {VehicleAttribute::AC_TEMP_MIN,15},
+    {VehicleAttribute::WIND_LEVEL_MAX,5},
+    {VehicleAttribute::ENGINE_TOTAL,1}
+};
+
+inline constexpr vehicleBaseParam TESLA_MODEL3_LONG_RANGE = {
+    {VehicleAttribute::BATTERY_CAPACITY,75},
+    {VehicleAttribute::BATTERY_VOLTAGE,350},
+    {VehicleAttribute::MAX_RANGE,560},
+    {VehicleAttribute::MAX_TORQUE,440},
+    {VehicleAttribute::MAX_AC_POWER,3000},
+    {VehicleAttribute::MAX_ENGINE_POWER,324},
+    {VehicleAttribute::MAX_SPEED_SPORT,233},
+    {VehicleAttribute::MAX_SPEED_ECO,190},
+    {VehicleAttribute::MAX_RPM,17000},
+    {VehicleAttribute::WEIGHT,1847},
+    {VehicleAttribute::WHEEL_RADIUS,35},
+    {VehicleAttribute::AC_TEMP_MAX,28},
+    {VehicleAttribute::AC_TEMP_MIN,15},
+    {VehicleAttribute::WIND_LEVEL_MAX,5},
+    {VehicleAttribute::ENGINE_TOTAL,2}
+};
+
+inline constexpr vehicleBaseParam HYUNDAI_IONIQ5_PERFORMANCE = {
+    {VehicleAttribute::BATTERY_CAPACITY,75},
+    {VehicleAttribute::BATTERY_VOLTAGE,350},
+    {VehicleAttribute::MAX_RANGE,530},
+    {VehicleAttribute::MAX_TORQUE,650},
+    {VehicleAttribute::MAX_AC_POWER,3500},
+    {VehicleAttribute::MAX_ENGINE_POWER,393},
+    {VehicleAttribute::MAX_SPEED_SPORT,261},
+    {VehicleAttribute::MAX_SPEED_ECO,210},
+    {VehicleAttribute::MAX_RPM,18000},
+    {VehicleAttribute::WEIGHT,1847},
+    {VehicleAttribute::WHEEL_RADIUS,36},
+    {VehicleAttribute::AC_TEMP_MAX,28},
+    {VehicleAttribute::AC_TEMP_MIN,15},
+    {VehicleAttribute::WIND_LEVEL_MAX,5},
+    {VehicleAttribute::ENGINE_TOTAL,2}
+};
+
+inline constexpr vehicleBaseParam HYUNDAI_IONIQ5 = {
+    {VehicleAttribute::BATTERY_CAPACITY,58},
+    {VehicleAttribute::BATTERY_VOLTAGE,360},
+    {VehicleAttribute::MAX_RANGE,400},
+    {VehicleAttribute::MAX_TORQUE,300},
+    {VehicleAttribute::MAX_AC_POWER,2500},
+    {VehicleAttribute::MAX_ENGINE_POWER,211},
+    {VehicleAttribute::MAX_SPEED_SPORT,225},
+    {VehicleAttribute::MAX_SPEED_ECO,160},
+    {VehicleAttribute::MAX_RPM,16000},
+    {VehicleAttribute::WEIGHT,1612},
+    {VehicleAttribute::WHEEL_RADIUS,34},
+    {VehicleAttribute::AC_TEMP_MAX,28},
+    {VehicleAttribute::AC_TEMP_MIN,15},
+    {VehicleAttribute::WIND_LEVEL_MAX,5},
+    {VehicleAttribute::ENGINE_TOTAL,1}
+};
+
+static_assert(TESLA_MODEL3_STANDARD.isComplete(), "Tesla model 3 standard is missing a design value");
+static_assert(TESLA_MODEL3_LONG_RANGE.isComplete(), "Tesla model 3 long range is missing a design value");
+static_assert(HYUNDAI_IONIQ5_PERFORMANCE.isComplete(), "Hyundai ioniq 5 performance is missing a design value");
+static_assert(HYUNDAI_IONIQ5.isComplete(), "Hyundai ioniq 5 is missing a design value");
+static_assert(!(vehicleBaseParam{} == vehicleBaseParam{{VehicleAttribute::WEIGHT, 0}}),
+              "an unset design value must not equal an explicit 0");
+
+// Design values of a built-in model, nullptr if there is none
+constexpr const vehicleBaseParam* builtInDesign(VehicleBrand brand, VehicleOption option) {
+    if (brand == VehicleBrand::TESLA && option == VehicleOption::STANDAND)           return &TESLA_MODEL3_STANDARD;
+    if (brand == VehicleBrand::TESLA && option == VehicleOption::LONG_RANGE)         return &TESLA_MODEL3_LONG_RANGE;
+    if (brand == VehicleBrand::HYUNDAI && option == VehicleOption::STANDAND)         return &HYUNDAI_IONIQ5;
+    if (brand == VehicleBrand::HYUNDAI && option == VehicleOption::PERFORMANCE)      return &HYUNDAI_IONIQ5_PERFORMANCE;
+    return nullptr;
+}
+
+class ProfileTables;
+
+/**
+ * @brief VehicleProfile struct
+ *
+ * Design values of one vehicle model, held by value so several vehicles
+ * can run side by side in one process. ElectricVehicleInit keeps the
+ * profile of the Dashboard; components built without a profile use it.
+ */
+struct VehicleProfile {
+    VehicleBrand brand = VehicleBrand::NOT_SET;
+    VehicleOption option = VehicleOption::NOT_SET;
+    vehicleBaseParam baseParam;
+    std::shared_ptr<const ProfileTables> tables;    // shared by every vehicle of the model
+
+    int getDesignValue(VehicleAttribute attribute) const { return baseParam[attribute]; }
+
+    static std::shared_ptr<const VehicleProfile> create(VehicleBrand brand, VehicleOption option); // nullptr if unknown
+    // A variant with its own design values; tables are built unless shared ones are given
+    static std::shared_ptr<const VehicleProfile> create(VehicleBrand brand, VehicleOption option,
+                                                        const vehicleBaseParam& baseParam,
+                                                        std::shared_ptr<const ProfileTables> tables = nullptr);
+};
 
 class ElectricVehicleInit {
 private:
@@ -237,6 +403,8 @@ private:
 public:
     ElectricVehicleInit(VehicleOption option, VehicleBrand brand);
     ~ElectricVehicleInit();
+
+    static void load(const VehicleProfile& profile);   // a profile from elsewhere, e.g. a ProfileCatalog
     
     static void displayVehicleInfo() {
         std::cout << "----------------------------------------" << std::endl;
@@ -255,16 +423,11 @@ public:
         std::cout << "----------------------------------------" << std::endl;
     }
 
-    static int getDesignValue(VehicleAttribute attribute) {
-        if (baseParam.find(attribute) != baseParam.end()) {
-            return baseParam[attribute];
-        } else {
-            return 0;
-        }
-    }
+    static int getDesignValue(VehicleAttribute attribute) { return baseParam[attribute]; }
 
     static VehicleBrand getBrand() { return brand; }
     static VehicleOption getOption() { return option; }
+    static VehicleProfile getProfile();     // copy of the loaded profile
 };
 
 #endif // VEHICLE_CONFIG_H
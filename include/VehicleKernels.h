@@ -0,0 +1,65 @@
+#ifndef VEHICLE_KERNELS_H
+#define VEHICLE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct KernelConstants;
+
+enum class KernelIsa {
+    SCALAR,     // portable loop over the VehicleCalculator functions
+    SSE2,       // 2 doubles per instruction
+    AVX2        // 4 doubles per instruction
+};
+
+/**
+ * @brief VehicleKernels class
+ *
+ * Array versions of the VehicleCalculator formulas for many vehicles or
+ * many time samples at once. Each call processes `count` elements of
+ * parallel arrays; the per-element branches of the scalar code (zero-speed
+ * start, RPM threshold, braking only while moving, coasting fallback) are
+ * evaluated as masks and blended, so SIMD lanes never diverge.
+ *
+ * The implementation is picked once at runtime from what the CPU supports
+ * (AVX2, then SSE2, then scalar) and can be forced with setIsa(). The SIMD
+ * paths perform the same operations in the same order without FMA, so they
+ * match the scalar functions bit for bit on IEEE-754 hardware; callers may
+ * rely on a relative difference of at most KERNEL_TOLERANCE.
+ */
+class VehicleKernels {
+public:
+    static constexpr double KERNEL_TOLERANCE = 1e-12;
+
+    static KernelIsa getIsa();
+    static void setIsa(KernelIsa isa);          // falls back to the best supported one
+    static KernelIsa detectIsa();               // best ISA this CPU supports
+    static const char* isaName(KernelIsa isa);
+
+    // rpm[i] = VehicleCalculator::getRpm(speed[i], ...), speed in m/s
+    static void rpm(const double* speed, size_t count, int wheelRadius, int maxRpm, double* rpmOut);
+    // torque[i] = VehicleCalculator::getTorque(rpm[i], maxRpm, gasLevel[i], maxTorque)
+    static void torque(const double* rpm, const int32_t* gasLevel, size_t count, int maxRpm, int maxTorque,
+                       double* torqueOut);
+    // getTractiveForce(wheelRadius, torque[i])
+    static void tractiveForce(const double* torque, size_t count, int wheelRadius, double* tractionOut);
+    // getPowerEngine(torque[i], getAngularSpeed(rpm[i]))
+    static void enginePower(const double* torque, const double* rpm, size_t count, double* powerOut);
+    // getAirDragForce(speed[i])
+    static void airDragForce(const double* speed, size_t count, double* dragOut);
+    // getAcceleration(speed[i], traction[i], weight, brakeLevel[i], lastAcceleration[i]), updates lastAcceleration
+    static void acceleration(const double* speed, const double* traction, const int32_t* brakeLevel, size_t count,
+                             int weight, double* lastAcceleration, double* accelerationOut);
+    // batteryTemp[i] = getBatteryTemp(batteryTemp[i], envTemp, enginePower[i]), in place
+    static void batteryTemp(double* batteryTemp, const double* enginePower, size_t count, double envTemp);
+    // One explicit step of a grid of cells with row pitch stride; temp[i +- 1] and temp[i +- stride] must be readable:
+    // out[i] = temp[i] + heatScale * heat[i] + conduction * (sum of the 4 neighbours - 4 * temp[i])
+    //          - coolingScale * cooling[i] * (temp[i] - coolantTemp)
+    static void cellTemp(const double* temp, const double* heat, const double* cooling, size_t count, size_t stride,
+                         double heatScale, double conduction, double coolingScale, double coolantTemp, double* out);
+
+private:
+    static const KernelConstants& constants();  // copied from VehicleCalculator
+};
+
+#endif // VEHICLE_KERNELS_H
@@ -0,0 +1,52 @@
+#ifndef VEHICLE_SIMULATION_H
+#define VEHICLE_SIMULATION_H
+
+#include "VehicleState.h"
+#include "SafetyManager.h"
+#include "SpeedCalculator.h"
+#include "BatteryManager.h"
+#include "SignalRegistry.h"
+
+/**
+ * @brief VehicleSimulation class
+ *
+ * One physics tick of a single vehicle, shared by the live mainLoop and
+ * TripReplay: drive mode, battery drain, range, battery temperature, speed,
+ * the range distribution and the pedal safety check, in that order. The caller starts the tick on
+ * the SimulationClock shared by the components first, so everything
+ * integrates over the same step. It does not own the components it drives.
+ */
+class VehicleSimulation {
+public:
+    VehicleSimulation(DriveMode* driveMode, SafetyManager* safetyManager,
+                      SpeedCalculator* speedCalculator, BatteryManager* batteryManager,
+                      const DriverInputs& initialInputs);
+
+    const VehicleState& step(const DriverInputs& inputs);    // advance by the clock's current tick
+    const VehicleState& getState() const { return state; }
+
+private:
+    DriveMode* driveMode;
+    SafetyManager* safetyManager;
+    SpeedCalculator* speedCalculator;
+    BatteryManager* batteryManager;
+
+    VehicleState state;
+    bool ecoModeChanged;    // slowing down to the ECO limit after leaving SPORT
+};
+
+// Driver controls as persisted in the data store, over the previous inputs
+DriverInputs inputsFromFrame(const SignalFrame& frame, DriverInputs inputs);
+
+// Last values written to the data store, so a tick only persists what visibly changed
+struct StoredSignals {
+    int speed = 0;
+    int batteryLevel = 0;
+    int remainingRange = 0;
+    int batteryTemp = 0;
+    int odometer = 0;
+
+    SignalBatch changes(const VehicleState& state);     // updates to write, remembered as stored
+};
+
+#endif // VEHICLE_SIMULATION_H
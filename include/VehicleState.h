@@ -0,0 +1,39 @@
+#ifndef VEHICLE_STATE_H
+#define VEHICLE_STATE_H
+
+#include "DriveMode.h"
+#include "SeqLock.h"
+
+// Driver controls, published by the input thread
+struct DriverInputs {
+    DriveMode::Mode driveMode = DriveMode::Mode::ECO;
+    bool acStatus = false;
+    bool isAccelerator = false;
+    bool isBrake = false;
+    int acTemp = 0;
+    int windLevel = 0;
+    int turnSignal = 0;
+};
+
+// Everything the physics loop computed in one tick, published as one snapshot
+struct VehicleState {
+    uint64_t tick = 0;
+    DriverInputs inputs;
+    int speed = 0;                  // km/h
+    int outputPower = 0;            // kW
+    double batteryLevel = 0.0;      // %
+    double remainingRange = 0.0;    // km
+    double rangeP10 = 0.0;          // km, Monte Carlo percentiles; 0 without a range distribution
+    double rangeP50 = 0.0;
+    double rangeP90 = 0.0;
+    double batteryTemp = 0.0;       // °C
+    double odometer = 0.0;          // km
+    bool isSafetyAction = false;    // brake and accelerator pressed together
+    int gasIntensity = 0;           // %
+    int brakeIntensity = 0;         // %
+};
+
+using DriverInputChannel = SeqLock<DriverInputs>;
+using VehicleStateChannel = SeqLock<VehicleState>;
+
+#endif // VEHICLE_STATE_H
@@ -1,32 +1,88 @@
 #include "BatteryManager.h"
 #include "VehicleConfig.h"
+#include <algorithm>
 
-static const double ENVIRONMENT_TEMP = 35.0;    
+BatteryManager::BatteryManager(SpeedCalculator* speedCalculator, SimulationClock* clock)
+    : BatteryManager(speedCalculator, clock, ElectricVehicleInit::getProfile()) {}
 
-BatteryManager::BatteryManager(SpeedCalculator* speedCalculator) {
+BatteryManager::BatteryManager(SpeedCalculator* speedCalculator, SimulationClock* clock, const VehicleProfile& profile)
+    : profile(profile), rangeModel(RangeModel::ENERGY_MAP), rangePredictor(profile), auxPower(0.0), observedDistance(-1.0),
+      rangePool(nullptr), sinceRangeRefresh(0.0) {
     this->speedCalculator = speedCalculator;
-    batteryMaxCapacity = (double)ElectricVehicleInit::getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    this->clock = clock;
+    batteryMaxCapacity = (double)profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
     batteryTemp = ENVIRONMENT_TEMP;
     drainPerKm = 0.1; 
     currentKwH = batteryMaxCapacity;
-    std::cout << "BatteryManager initialized" << std::endl;
+    batteryCapacity = 100.0;
+    maxRange = profile.getDesignValue(VehicleAttribute::MAX_RANGE);
+    maxAcPower = profile.getDesignValue(VehicleAttribute::MAX_AC_POWER);
+    previousDrainPerKm = 0.1;
 }
 
-BatteryManager::~BatteryManager() {
-    delete speedCalculator;
+void BatteryManager::setProfile(const VehicleProfile& profile) {
+    batteryMaxCapacity = (double)profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    currentKwH = batteryMaxCapacity * batteryCapacity / 100.0;
+    maxRange = profile.getDesignValue(VehicleAttribute::MAX_RANGE);
+    maxAcPower = profile.getDesignValue(VehicleAttribute::MAX_AC_POWER);
+    rangePredictor = RangePredictor(profile);
+    this->profile = profile;
+    if (rangeDistribution) {
+        enableRangeDistribution(rangePool, rangeDistribution->getSampleCount());
+    }
+}
+
+BatteryManager::~BatteryManager() {}
+
+void BatteryManager::restoreBatteryLevel(double batteryLevel) {
+    if (batteryLevel < 0.0) batteryLevel = 0.0;
+    if (batteryLevel > 100.0) batteryLevel = 100.0;
+    batteryCapacity = batteryLevel;
+    currentKwH = batteryMaxCapacity * batteryLevel / 100.0;
+}
+
+void BatteryManager::enablePackModel(const PackThermalConfig& config) {
+    packModel.reset(new PackThermalModel(config));
+}
+
+void BatteryManager::enableRangeDistribution(ThreadPool* pool, size_t samples) {
+    rangeDistribution.reset(new MonteCarloRange(profile, samples, pool));
+    rangePool = pool;
+    sinceRangeRefresh = RANGE_REFRESH_SECONDS;  // the first slice on the next update
+}
+
+void BatteryManager::updateRangeDistribution(const DriverInputs& inputs) {
+    if (!rangeDistribution) {
+        return;
+    }
+    double deltaTime = clock->getDeltaTime();
+    rangeDistribution->observe(inputs, speedCalculator->getCurrentSpeed(), deltaTime);
+    sinceRangeRefresh += deltaTime;
+    // A slice still running keeps the last percentiles; the next one starts on the first tick after it
+    if (sinceRangeRefresh >= RANGE_REFRESH_SECONDS &&
+        rangeDistribution->refreshAsync(std::max<size_t>(rangeDistribution->getSampleCount() / RANGE_REFRESH_SHARE, 1))) {
+        sinceRangeRefresh = 0.0;
+    }
+}
+
+RangePercentiles BatteryManager::getRangePercentiles() const {
+    return rangeDistribution ? rangeDistribution->estimate(currentKwH) : RangePercentiles();
 }
 
 double BatteryManager::calculateBatteryTemp() {
     double powerEngine = speedCalculator->getPowerConsumption();
+    if (packModel) {
+        packModel->update(powerEngine + auxPower, clock->getDeltaTime());
+        batteryTemp = packModel->getMaxTemp();
+        return batteryTemp;
+    }
     batteryTemp = VehicleCalculator::getBatteryTemp(batteryTemp, ENVIRONMENT_TEMP, powerEngine);
     return batteryTemp;
 }
 
 double BatteryManager::calculateDrainPerKm(int acTemp, int windLevel) const {
-    static const int MAX_AC_POWER = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_AC_POWER);
-
     double enginePower = speedCalculator->getPowerConsumption();
-    int acPower = VehicleCalculator::getPowerAC(ENVIRONMENT_TEMP, acTemp, MAX_AC_POWER);
+    int acPower = VehicleCalculator::getPowerAC(ENVIRONMENT_TEMP, acTemp, maxAcPower);
     int windPower = VehicleCalculator::getPowerWind(windLevel);
 
     double drainKwH = (enginePower + acPower + windPower) / 1000.0;
@@ -35,6 +91,14 @@ double BatteryManager::calculateDrainPerKm(int acTemp, int windLevel) const {
 }
 
 double BatteryManager::calculateRemainingRange() {
+    if (rangeModel == RangeModel::ENERGY_MAP) {
+        double remainingRange = rangePredictor.predictRange(currentKwH, auxPower);
+        return remainingRange > maxRange ? maxRange : remainingRange;
+    }
+    return calculateEmaRange();
+}
+
+double BatteryManager::calculateEmaRange() const {
     // Get current battery capacity in kWh
     double currentBatteryCapacity = getBatteryKwH();
     
@@ -43,50 +107,47 @@ double BatteryManager::calculateRemainingRange() {
     // Calculate remaining range in km
     double remainingRange = currentBatteryCapacity / effectiveDrainRate;
     
-    static const int MAX_RANGE = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RANGE);
-    
-    if (remainingRange > MAX_RANGE) {
-        remainingRange = MAX_RANGE;
+    if (remainingRange > maxRange) {
+        remainingRange = maxRange;
     }
     
     return remainingRange;
 }
 
 void BatteryManager::updateBatteryCapacity(int acTemp, int windLevel) {
-    static auto previousTime = std::chrono::high_resolution_clock::now();
-    auto now = std::chrono::high_resolution_clock::now();
-    double deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - previousTime).count() / 1000.0; // Convert ms to seconds
-    
-    if (deltaTime <= 0.001) deltaTime = 0.001;
-    if (deltaTime > 1.0) deltaTime = 1.0;
-    
+    double deltaTime = clock->getDeltaTime();
     double drainKwHPerSecond = calculateDrainPerKm(acTemp, windLevel);
+    double previousKwH = currentKwH;
     
     currentKwH -= drainKwHPerSecond * deltaTime;
     
     if (currentKwH < 0) {
         currentKwH = 0;
     }
+
+    // Feed the energy map with this tick's speed, distance and consumption
+    auxPower = VehicleCalculator::getPowerAC(ENVIRONMENT_TEMP, acTemp, maxAcPower) + VehicleCalculator::getPowerWind(windLevel);
+    double distance = speedCalculator->getTotalDistance();
+    if (observedDistance >= 0.0) {
+        rangePredictor.observe(speedCalculator->getCurrentSpeed(), distance - observedDistance, previousKwH - currentKwH,
+                               auxPower, deltaTime);
+    }
+    observedDistance = distance;
     
     // Update battery percentage
     batteryCapacity = (currentKwH / batteryMaxCapacity) * 100.0; 
-    // Get maximum range from vehicle configuration
-    static const int MAX_RANGE = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RANGE);
     // Get current distance traveled
     double currentRangeTraveled = speedCalculator->getTotalDistance();
     // Only update drain rate if we've traveled some distance
     if (currentRangeTraveled > 0.1) {
         double energyUsed = batteryMaxCapacity - currentKwH;
         drainPerKm = energyUsed / currentRangeTraveled;
-        static double previousDrainPerKm = 0.1; // Default starting value
         drainPerKm = 0.9 * previousDrainPerKm + 0.1 * drainPerKm; // Exponential moving average
         previousDrainPerKm = drainPerKm;
     } else {
         // Use a default value when we haven't traveled far enough
-        drainPerKm = batteryMaxCapacity / MAX_RANGE;
+        drainPerKm = batteryMaxCapacity / maxRange;
     }
     
     if (drainPerKm < 0.001) drainPerKm = 0.1; // Minimum drain rate
-    
-    previousTime = now;
 }
\ No newline at end of file
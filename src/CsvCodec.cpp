@@ -0,0 +1,68 @@
+#include "CsvCodec.h"
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool readFile(const std::string& path, std::string& buffer) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    buffer.resize(info.st_size);
+    size_t total = 0;
+    while (total < buffer.size()) {
+        ssize_t count = read(fd, &buffer[total], buffer.size() - total);
+        if (count <= 0) {
+            break;
+        }
+        total += count;
+    }
+    buffer.resize(total);
+    close(fd);
+    return true;
+}
+
+void CsvWriter::begin() {
+    buffer.clear();
+    buffer.append(CSV_HEADER);
+    buffer.push_back('\n');
+}
+
+void CsvWriter::appendRow(std::string_view key, std::string_view value) {
+    buffer.append(key);
+    buffer.push_back(',');
+    buffer.append(value);
+    buffer.push_back('\n');
+}
+
+void CsvWriter::appendSignal(SignalId id, double value) {
+    char text[SIGNAL_TEXT_MAX];
+    appendRow(signalInfo(id).csvName, std::string_view(text, formatSignal(id, value, text)));
+}
+
+bool CsvWriter::writeFile(const std::string& path) const {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        std::cerr << "Failed to open file for writing: " << path << std::endl;
+        return false;
+    }
+    // One syscall for the whole file; loop only on a short write
+    size_t total = 0;
+    while (total < buffer.size()) {
+        ssize_t count = write(fd, buffer.data() + total, buffer.size() - total);
+        if (count <= 0) {
+            std::cerr << "Failed to write file: " << path << std::endl;
+            close(fd);
+            return false;
+        }
+        total += count;
+    }
+    close(fd);
+    return true;
+}
@@ -3,27 +3,50 @@
 #define EXIST 1
 #define NOT_EXIST 0
 
-DashboardController::DashboardController() {
-    std::cout << "DashboardController initialized" << std::endl;
-}
+DashboardController::DashboardController() : knownMask(0), reads(0), notifications(0) {}
 
 DashboardController::~DashboardController() {}
 
-void DashboardController::readData(const std::unordered_map<std::string, std::string>& newData) {
-    for (const auto& [key, value] : newData) {
-        if (key == "VEHICLE_SPEED")    speed = std::stoi(value);
-        else if (key == "DRIVE_MODE")    driveMode = value;
-        else if (key == "BATTERY_LEVEL")    batteryLevel = std::stoi(value);
-        else if (key == "ROUTE_PLANNER")    remainingRange = std::stoi(value);
-        else if (key == "WIND_LEVEL")    windLevel = std::stoi(value);
-        else if (key == "AC_CONTROL")    climateTemp = std::stoi(value);
-        else if (key == "TURN_SIGNAL")    turnSignal = std::stoi(value);
-        else if (key == "BRAKE")    isBrake = strToBool(value);
-        else if (key == "ACCELERATOR")    isAccelerator = strToBool(value);
-        else if (key == "AC_STATUS")    acStatus = strToBool(value);
+template <class T>
+static void assign(T& field, T value, SignalId id, uint32_t& changed) {
+    if (field != value) {
+        field = value;
+        changed |= signalBit(id);
     }
+}
+
+void DashboardController::readData(const SignalFrame& newData) {
+    reads++;
+    uint32_t present = newData.presentMask & DASHBOARD_SIGNALS;
+    uint32_t changed = present & ~knownMask;       // first reads always count as changes
+    knownMask |= present;
 
-    notifyObservers();
+    if (newData.has(SignalId::VEHICLE_SPEED))
+        assign(snapshot.speed, static_cast<uint16_t>(newData.getInt(SignalId::VEHICLE_SPEED)), SignalId::VEHICLE_SPEED, changed);
+    if (newData.has(SignalId::DRIVE_MODE))
+        assign(snapshot.driveMode, newData.get(SignalId::DRIVE_MODE) == DRIVE_MODE_SPORT ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO,
+               SignalId::DRIVE_MODE, changed);
+    if (newData.has(SignalId::BATTERY_LEVEL))
+        assign(snapshot.batteryLevel, newData.getInt(SignalId::BATTERY_LEVEL), SignalId::BATTERY_LEVEL, changed);
+    if (newData.has(SignalId::ROUTE_PLANNER))
+        assign(snapshot.remainingRange, static_cast<uint16_t>(newData.getInt(SignalId::ROUTE_PLANNER)), SignalId::ROUTE_PLANNER, changed);
+    if (newData.has(SignalId::WIND_LEVEL))
+        assign(snapshot.windLevel, newData.getInt(SignalId::WIND_LEVEL), SignalId::WIND_LEVEL, changed);
+    if (newData.has(SignalId::AC_CONTROL))
+        assign(snapshot.climateTemp, newData.getInt(SignalId::AC_CONTROL), SignalId::AC_CONTROL, changed);
+    if (newData.has(SignalId::TURN_SIGNAL))
+        assign(snapshot.turnSignal, newData.getInt(SignalId::TURN_SIGNAL), SignalId::TURN_SIGNAL, changed);
+    if (newData.has(SignalId::BRAKE))
+        assign(snapshot.isBrake, newData.getBool(SignalId::BRAKE), SignalId::BRAKE, changed);
+    if (newData.has(SignalId::ACCELERATOR))
+        assign(snapshot.isAccelerator, newData.getBool(SignalId::ACCELERATOR), SignalId::ACCELERATOR, changed);
+    if (newData.has(SignalId::AC_STATUS))
+        assign(snapshot.acStatus, newData.getBool(SignalId::AC_STATUS), SignalId::AC_STATUS, changed);
+
+    if (changed != 0) {
+        notifications++;
+        notifyObservers(changed);
+    }
 }
 
 void DashboardController::registerObserver(Observer* observer) {
@@ -36,11 +59,10 @@ void DashboardController::registerObserver(Observer* observer) {
 
 void DashboardController::unregisterObserver(Observer* observer) {
     observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
-    std::cout << "Observer unregistered" << std::endl;
 }
 
-void DashboardController::notifyObservers() const {
+void DashboardController::notifyObservers(uint32_t changed) const {
     for (const auto& observer : observers) {
-        observer->update(speed, remainingRange, batteryLevel, climateTemp, windLevel, turnSignal, driveMode, isBrake, isAccelerator, acStatus);
+        observer->update(snapshot, changed);
     }
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "DashboardSession.h"
+
+DashboardSession::DashboardSession(int id, std::shared_ptr<const VehicleProfile> profile, const std::string& storePath,
+                                   StorageBackend backend, double step)
+    : id(id), profile(std::move(profile)),
+      // Sessions are driven through setInputs(), not by editing their files, and
+      // persist their store from step() rather than on a writer thread each
+      dataHandler(DataHandler::open(storePath, backend, false, WriterMode::SERVICED)),
+      driveMode(*this->profile),
+      clock(SimulationClock::Mode::FIXED_STEP, step),
+      speedCalculator(&driveMode, &safetyManager, &clock, *this->profile),
+      batteryManager(&speedCalculator, &clock, *this->profile),
+      seenVersion(0) {
+    if (!dataHandler) {
+        std::cerr << "Session " << id << " has no data store" << std::endl;
+        return;
+    }
+    DriverInputs inputs = initStore();
+    storedInputs = inputs;
+    driverInputs.store(inputs);
+    simulation = std::make_unique<VehicleSimulation>(&driveMode, &safetyManager, &speedCalculator, &batteryManager, inputs);
+    VehicleState state = simulation->getState();
+    vehicleState.store(state);
+    stored.odometer = static_cast<int>(state.odometer);
+}
+
+DashboardSession::~DashboardSession() {
+    if (dataHandler) {
+        dataHandler->shutdown();
+    }
+}
+
+// Same start as the Dashboard's vehicleInit(): resume a recovered journal or reset the store
+DriverInputs DashboardSession::initStore() {
+    if (dataHandler->hasRecoveredState()) {
+        SignalFrame recovered = dataHandler->readSignals();
+        if (recovered.has(SignalId::BATTERY_LEVEL)) batteryManager.restoreBatteryLevel(recovered.get(SignalId::BATTERY_LEVEL));
+        if (recovered.has(SignalId::ODOMETER))      speedCalculator.restoreDistance(recovered.get(SignalId::ODOMETER));
+        dataHandler->updateSignals({
+            {SignalId::VEHICLE_SPEED, 0},
+            {SignalId::BRAKE, 0},
+            {SignalId::ACCELERATOR, 0},
+            {SignalId::TURN_SIGNAL, 0}
+        });
+        return inputsFromFrame(dataHandler->readSignals(), DriverInputs());
+    }
+
+    dataHandler->updateSignals({
+        {SignalId::VEHICLE_SPEED, 0},
+        {SignalId::DRIVE_MODE, DRIVE_MODE_ECO},
+        {SignalId::WIND_LEVEL, 2},
+        {SignalId::BATTERY_LEVEL, 100},
+        {SignalId::AC_STATUS, 1},
+        {SignalId::AC_CONTROL, 22},
+        {SignalId::BATTERY_TEMP, 35},
+        {SignalId::BRAKE, 0},
+        {SignalId::ACCELERATOR, 0},
+        {SignalId::ODOMETER, 0},
+        {SignalId::ROUTE_PLANNER, static_cast<double>(profile->getDesignValue(VehicleAttribute::MAX_RANGE))},
+        {SignalId::TURN_SIGNAL, 0}
+    });
+    return inputsFromFrame(dataHandler->readSignals(), DriverInputs());
+}
+
+void DashboardSession::setInputs(const DriverInputs& inputs) {
+    driverInputs.store(inputs);
+}
+
+void DashboardSession::collectInputChanges(const DriverInputs& inputs, SignalBatch& updates) {
+    if (inputs.isAccelerator != storedInputs.isAccelerator) updates.set(SignalId::ACCELERATOR, inputs.isAccelerator ? 1.0 : 0.0);
+    if (inputs.isBrake != storedInputs.isBrake)             updates.set(SignalId::BRAKE, inputs.isBrake ? 1.0 : 0.0);
+    if (inputs.acStatus != storedInputs.acStatus)           updates.set(SignalId::AC_STATUS, inputs.acStatus ? 1.0 : 0.0);
+    if (inputs.acTemp != storedInputs.acTemp)               updates.set(SignalId::AC_CONTROL, inputs.acTemp);
+    if (inputs.windLevel != storedInputs.windLevel)         updates.set(SignalId::WIND_LEVEL, inputs.windLevel);
+    if (inputs.turnSignal != storedInputs.turnSignal)       updates.set(SignalId::TURN_SIGNAL, inputs.turnSignal);
+    if (inputs.driveMode != storedInputs.driveMode) {
+        updates.set(SignalId::DRIVE_MODE, inputs.driveMode == DriveMode::Mode::SPORT ? DRIVE_MODE_SPORT : DRIVE_MODE_ECO);
+    }
+    storedInputs = inputs;
+}
+
+void DashboardSession::step() {
+    if (!simulation) {
+        return;
+    }
+    DriverInputs inputs = driverInputs.load();
+    SignalBatch updates;
+    collectInputChanges(inputs, updates);
+
+    clock.tick();
+    VehicleState state = simulation->step(inputs);
+    vehicleState.store(state);
+
+    for (const auto& update : stored.changes(state)) {
+        updates.set(update.id, update.value);
+    }
+    if (!updates.empty()) {
+        dataHandler->updateSignals(updates);
+    }
+
+    uint64_t version = dataHandler->getVersion();
+    if (version != seenVersion) {
+        seenVersion = version;
+        dashboardController.readData(dataHandler->readSignals());
+    }
+    dataHandler->service();
+}
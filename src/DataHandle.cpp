@@ -1,64 +1,680 @@
 #include "DataHandler.h"
+#include "MappedStateStorage.h"
+#include "JournalStorage.h"
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <vector>
+
+#define CSV_FILE "../data/Database.csv"
+
+static const int EXTERNAL_POLL_MS = 50;    // backends whose writers inotify cannot see
 
 DataHandler* DataHandler::instance = nullptr;
 std::mutex DataHandler::mtx;
 
-DataHandler::DataHandler(const std::string& filename) : filename(filename) {}
+static int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+DataHandler::DataHandler(std::unique_ptr<StateStorage> storage, StorageBackend backend, bool watchExternalWrites,
+                         WriterMode writerMode)
+    : storage(std::move(storage)), backend(backend), writerMode(writerMode), presentMask(0), writerIdle(false), stopWriter(false),
+      writerExited(false), flushRequests(0), flushesDone(0), wakeThreshold(1), pendingMask(0), firstPendingNanos(0), persistFailed(false), storedMask(0),
+      updateCalls(0), keyWrites(0), commandsEnqueued(0), maxQueueDepth(0), queueFullWaits(0),
+      version(0), lastCommitNanos(0), changeWaiters(0), stopping(false), stopEventFd(-1) {
+    for (auto& value : values) {
+        value.store(0.0, std::memory_order_relaxed);
+    }
+    pendingSince.fill(0);
+    wakeThreshold = this->storage->isWriteThrough() ? 1 : policy.dirtyThreshold;
+    SignalFrame stored;
+    CSVMap storedExtras;
+    this->storage->loadFrame(stored, storedExtras);
+    mergeFromStorage(stored, storedExtras);
+    lastCommitNanos = nowNanos();
+    lastSelfWrite = stampFile();
+    if (writerMode == WriterMode::THREAD) {
+        writer = std::thread(&DataHandler::writerLoop, this);
+    }
+
+    if (!watchExternalWrites || !this->storage->supportsExternalWriters()) {
+        return;
+    }
+    stopEventFd = eventfd(0, EFD_NONBLOCK);
+    if (stopEventFd != -1) {
+        watcher = std::thread(&DataHandler::watchLoop, this);
+    } else {
+        std::cerr << "Failed to create eventfd, external changes will not be detected" << std::endl;
+    }
+}
+
+DataHandler::~DataHandler() {
+    shutdown();
+    std::lock_guard<std::mutex> lock(mtx);
+    if (instance == this) {
+        instance = nullptr;
+    }
+}
 
-DataHandler* DataHandler::getInstance() {
+// Database.csv -> Database.bin / Database.journal; falls back to CSV when the mapping fails
+std::unique_ptr<StateStorage> DataHandler::createStorage(const std::string& csvPath, StorageBackend& backend,
+                                                         WriterMode writerMode) {
+    std::string stem = csvPath;
+    if (stem.size() > 4 && stem.compare(stem.size() - 4, 4, ".csv") == 0) {
+        stem.resize(stem.size() - 4);
+    }
+    if (backend == StorageBackend::MAPPED) {
+        auto mapped = std::make_unique<MappedStateStorage>(stem + ".bin", csvPath);
+        if (mapped->isOpen()) {
+            return mapped;
+        }
+        std::cerr << "Falling back to CSV storage" << std::endl;
+    } else if (backend == StorageBackend::JOURNAL) {
+        // A serviced store compacts its journal in service() instead of on a thread of its own
+        return std::make_unique<JournalStorage>(csvPath, stem + ".journal", JournalStorage::DEFAULT_COMPACT_THRESHOLD,
+                                                writerMode == WriterMode::THREAD);
+    }
+    backend = StorageBackend::CSV;
+    return std::make_unique<CsvStorage>(csvPath);
+}
+
+DataHandler* DataHandler::getInstance(StorageBackend backend) {
     std::lock_guard<std::mutex> lock(mtx); // lock the mutex
     if (instance == nullptr) {
-        instance = new DataHandler("../data/Database.csv"); // Create instance with default filename
+        StorageBackend used = backend;
+        std::unique_ptr<StateStorage> storage = createStorage(CSV_FILE, used, WriterMode::THREAD);
+        instance = new DataHandler(std::move(storage), used, true, WriterMode::THREAD);
+    } else if (instance->backend != backend) {
+        std::cerr << "DataHandler already created with another storage backend" << std::endl;
     }
     return instance;
 }
 
-CSVMap DataHandler::readData() {
-    std::ifstream infile(filename);
-    if (!infile.is_open()) {
-        std::cerr << "Failed to open file: " << filename << std::endl;
-        return {};
+std::unique_ptr<DataHandler> DataHandler::open(const std::string& csvPath, StorageBackend backend, bool watchExternalWrites,
+                                               WriterMode writerMode) {
+    // A new store starts from an empty file rather than a load error
+    struct stat info;
+    if (stat(csvPath.c_str(), &info) != 0) {
+        int fd = ::open(csvPath.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (fd == -1) {
+            std::cerr << "Failed to create file: " << csvPath << std::endl;
+            return nullptr;
+        }
+        ::close(fd);
     }
+    StorageBackend used = backend;
+    std::unique_ptr<StateStorage> storage = createStorage(csvPath, used, writerMode);
+    return std::unique_ptr<DataHandler>(new DataHandler(std::move(storage), used, watchExternalWrites, writerMode));
+}
 
-    CSVMap data;
-    std::string line, key, value;
-    std::getline(infile, line); // Skip header
+CSVMap DataHandler::readData() {
+    return toCsv();
+}
 
-    while (std::getline(infile, line)) {
-        std::stringstream ss(line);
-        if (std::getline(ss, key, ',') && std::getline(ss, value)) {
-            data[key] = value;
-        }
+SignalFrame DataHandler::readSignals() {
+    SignalFrame frame;
+    frame.presentMask = presentMask.load(std::memory_order_acquire);
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        frame.values[i] = values[i].load(std::memory_order_relaxed);
     }
-    
-    infile.close();
-    return data;
+    return frame;
 }
 
 void DataHandler::updateData(const CSVMap& updates) {
-    CSVMap data = readData();
-    // Update data
+    updateCalls.fetch_add(1, std::memory_order_relaxed);
+    keyWrites.fetch_add(updates.size(), std::memory_order_relaxed);
+    int64_t enqueueNanos = nowNanos();
+    bool changed = false;
+    SignalId id;
+    double value;
     for (const auto& [k, v] : updates) {
-        data[k] = v;
+        if (!findSignal(k, id)) {
+            changed = applyExtra(k, v) || changed;
+            continue;
+        }
+        if (!parseSignal(id, v, value)) {
+            std::cerr << "Invalid value for " << k << ": " << v << std::endl;
+            continue;
+        }
+        if (applySignal(id, value)) {
+            enqueue({id, enqueueNanos});
+            changed = true;
+        }
     }
-    // Write updated data
-    std::ofstream outfile(filename);
-    if (!outfile.is_open()) {
-        std::cerr << "Failed to open file for writing: " << filename << std::endl;
-        return;
+    if (changed) {
+        commit();
+    }
+}
+
+void DataHandler::updateSignals(const SignalBatch& updates) {
+    updateCalls.fetch_add(1, std::memory_order_relaxed);
+    keyWrites.fetch_add(updates.size(), std::memory_order_relaxed);
+    int64_t enqueueNanos = nowNanos();
+    bool changed = false;
+    for (const auto& update : updates) {
+        if (applySignal(update.id, update.value)) {
+            enqueue({update.id, enqueueNanos});
+            changed = true;
+        }
+    }
+    if (changed) {
+        commit();
+    }
+}
+
+// Store one signal, returns true if its value changed
+bool DataHandler::applySignal(SignalId id, double value) {
+    uint32_t bit = signalBit(id);
+    double previous = values[signalIndex(id)].exchange(value, std::memory_order_relaxed);
+    uint32_t previousMask = presentMask.fetch_or(bit, std::memory_order_release);
+    return !(previousMask & bit) || previous != value;
+}
+
+bool DataHandler::applyExtra(const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lock(extrasMutex);
+    std::string& current = extras[key];
+    if (current == value) {
+        return false;
+    }
+    current = value;
+    dirtyExtras.insert(key);
+    return true;
+}
+
+// Values read back from storage are not queued for persistence. A signal
+// whose in-memory value differs from what storage held before holds a local
+// update that is not persisted yet, and so does a dirty extra: both keep
+// the local value, which the next flush writes over the external one.
+bool DataHandler::mergeFromStorage(const SignalFrame& frame, const CSVMap& data) {
+    bool changed = false;
+    for (const auto& info : SIGNALS) {
+        if (!frame.has(info.id)) {
+            continue;
+        }
+        size_t index = signalIndex(info.id);
+        uint32_t bit = signalBit(info.id);
+        double external = frame.get(info.id);
+        if (!(presentMask.load(std::memory_order_acquire) & bit)) {
+            changed = applySignal(info.id, external) || changed;
+        } else if (storedMask & bit) {
+            // Only replace the stored value, so an update swapped in meanwhile wins
+            double expected = storedValues[index];
+            if (expected != external && values[index].compare_exchange_strong(expected, external, std::memory_order_relaxed)) {
+                changed = true;
+            }
+        }
+    }
+    markStored(frame);
+    if (data.empty()) {
+        return changed;
     }
-    outfile << "key,value" << std::endl;
-    // Write data
+    std::lock_guard<std::mutex> lock(extrasMutex);
     for (const auto& [k, v] : data) {
-        outfile << k << "," << v << std::endl;
+        if (dirtyExtras.count(k)) {
+            continue;
+        }
+        std::string& current = extras[k];
+        changed = (current != v) || changed;
+        current = v;
+    }
+    return changed;
+}
+
+void DataHandler::markStored(const SignalFrame& frame) {
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        if (frame.presentMask & (1u << i)) {
+            storedValues[i] = frame.values[i];
+        }
+    }
+    storedMask |= frame.presentMask;
+}
+
+// Push a command, waiting for the writer only if the queue is full
+void DataHandler::enqueue(const UpdateCommand& command) {
+    while (!queue.tryPush(command)) {
+        queueFullWaits.fetch_add(1, std::memory_order_relaxed);
+        if (stopping.load(std::memory_order_acquire) || writerMode == WriterMode::SERVICED) {
+            flush();
+        } else {
+            wakeWriter();
+            std::this_thread::yield();
+        }
+    }
+    commandsEnqueued.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t depth = queue.size();
+    uint64_t deepest = maxQueueDepth.load(std::memory_order_relaxed);
+    while (depth > deepest && !maxQueueDepth.compare_exchange_weak(deepest, depth, std::memory_order_relaxed)) {
+    }
+    if (depth >= wakeThreshold.load(std::memory_order_relaxed)) {
+        wakeWriter();
     }
-    outfile.close();
+}
+
+// Only signal the writer when it is parked, so the common case stays lock-free
+void DataHandler::wakeWriter() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerIdle.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerCv.notify_one();
+    }
+}
+
+void DataHandler::commit() {
+    lastCommitNanos.store(nowNanos(), std::memory_order_relaxed);
+    version.fetch_add(1, std::memory_order_seq_cst);
+    if (changeWaiters.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(changeMutex);
+        changeCv.notify_all();
+    }
+}
+
+CSVMap DataHandler::toCsv() {
+    CSVMap data;
+    {
+        std::lock_guard<std::mutex> lock(extrasMutex);
+        data = extras;
+    }
+    SignalFrame frame = readSignals();
+    for (const auto& info : SIGNALS) {
+        if (frame.has(info.id)) {
+            data[info.csvName] = formatSignal(info.id, frame.get(info.id));
+        }
+    }
+    return data;
+}
+
+bool DataHandler::waitForChange(uint64_t& seenVersion, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(changeMutex);
+    changeWaiters.fetch_add(1, std::memory_order_seq_cst);
+    changeCv.wait_for(lock, timeout, [this, &seenVersion] {
+        return version.load(std::memory_order_seq_cst) != seenVersion || stopping.load(std::memory_order_acquire);
+    });
+    changeWaiters.fetch_sub(1, std::memory_order_relaxed);
+    uint64_t current = version.load(std::memory_order_acquire);
+    if (current == seenVersion) {
+        return false;
+    }
+    seenVersion = current;
+    notifyLatency.record(nowNanos() - lastCommitNanos.load(std::memory_order_relaxed));
+    return true;
 }
 
 std::string DataHandler::getValue(const std::string& key) {
-    CSVMap data = readData();
-    std::lock_guard<std::mutex> lock(mtx);
-    if (data.find(key) != data.end()) {
-        return data.at(key);
+    SignalId id;
+    if (findSignal(key, id)) {
+        if (!(presentMask.load(std::memory_order_acquire) & signalBit(id))) {
+            return "";
+        }
+        return formatSignal(id, values[signalIndex(id)].load(std::memory_order_relaxed));
+    }
+    std::lock_guard<std::mutex> lock(extrasMutex);
+    auto it = extras.find(key);
+    if (it != extras.end()) {
+        return it->second;
+    }
+    return "";
+}
+
+void DataHandler::setFlushPolicy(const FlushPolicy& newPolicy) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    policy = newPolicy;
+    if (!storage->isWriteThrough()) {
+        wakeThreshold = policy.dirtyThreshold;
+    }
+    writerCv.notify_one();
+}
+
+void DataHandler::flush() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    bool ownWriter = writerMode == WriterMode::THREAD;
+    if (ownWriter && !writerExited) {
+        uint64_t ticket = ++flushRequests;
+        writerCv.notify_one();
+        flushDoneCv.wait(lock, [this, ticket] { return flushesDone >= ticket || writerExited; });
+    }
+    if (!ownWriter || writerExited) {
+        // No writer thread (any more), drain on the caller's thread
+        drainQueue();
+        persistPending();
     }
-}
\ No newline at end of file
+    lock.unlock();
+    if (storage->isWriteThrough()) {
+        storage->sync();
+    }
+}
+
+void DataHandler::service() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (writerMode != WriterMode::SERVICED || stopWriter) {
+        return;
+    }
+    drainQueue();
+    if (isFlushDue(policy)) {
+        persistPending();
+    }
+    storage->maintain();
+}
+
+void DataHandler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (stopWriter) {
+            return;
+        }
+        stopWriter = true;
+    }
+    writerCv.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(changeMutex);
+        changeCv.notify_all();
+    }
+    if (stopEventFd != -1) {
+        uint64_t one = 1;
+        if (write(stopEventFd, &one, sizeof(one)) != sizeof(one)) {
+            std::cerr << "Failed to stop file watcher" << std::endl;
+        }
+        if (watcher.joinable()) {
+            watcher.join();
+        }
+        close(stopEventFd);
+        stopEventFd = -1;
+    }
+    flush();
+}
+
+DataHandlerStats DataHandler::getStats() {
+    DataHandlerStats stats;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats = writerStats;
+    }
+    stats.updateCalls = updateCalls.load(std::memory_order_relaxed);
+    stats.keyWrites = keyWrites.load(std::memory_order_relaxed);
+    stats.commandsEnqueued = commandsEnqueued.load(std::memory_order_relaxed);
+    stats.queueDepth = queue.size();
+    stats.maxQueueDepth = maxQueueDepth.load(std::memory_order_relaxed);
+    stats.queueFullWaits = queueFullWaits.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool DataHandler::exportCsv(const std::string& csvPath) {
+    CSVMap extrasSnapshot;
+    {
+        std::lock_guard<std::mutex> lock(extrasMutex);
+        extrasSnapshot = extras;
+    }
+    return CsvStorage(csvPath).persistFrame(readSignals(), extrasSnapshot);
+}
+
+// Move queued commands into the per-key pending set, returns how many were drained
+size_t DataHandler::drainQueue() {
+    UpdateCommand command;
+    size_t drained = 0;
+    uint64_t coalesced = 0;
+    while (queue.tryPop(command)) {
+        uint32_t bit = signalBit(command.id);
+        if (pendingMask & bit) {
+            coalesced++;
+        } else {
+            pendingMask |= bit;
+            pendingSince[signalIndex(command.id)] = command.enqueueNanos;
+        }
+        if (firstPendingNanos == 0 || command.enqueueNanos < firstPendingNanos) {
+            firstPendingNanos = command.enqueueNanos;
+        }
+        drained++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(extrasMutex);
+        if (!dirtyExtras.empty() && firstPendingNanos == 0) {
+            firstPendingNanos = nowNanos();
+        }
+    }
+    if (drained > 0) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        writerStats.coalescedWrites += coalesced;
+        writerStats.batchCount++;
+        if (drained > writerStats.maxBatchSize) {
+            writerStats.maxBatchSize = drained;
+        }
+    }
+    return drained;
+}
+
+size_t DataHandler::pendingCount() {
+    std::lock_guard<std::mutex> lock(extrasMutex);
+    return __builtin_popcount(pendingMask) + dirtyExtras.size();
+}
+
+// The oldest pending key waited an interval, or enough keys are dirty
+bool DataHandler::isFlushDue(const FlushPolicy& current) {
+    bool due = firstPendingNanos != 0 &&
+               nowNanos() - firstPendingNanos >= std::chrono::duration_cast<std::chrono::nanoseconds>(current.interval).count();
+    return due || (!persistFailed && (storage->isWriteThrough() || pendingCount() >= current.dirtyThreshold));
+}
+
+// Persist every pending key; the latest in-memory value wins over the queued one
+bool DataHandler::persistPending() {
+    size_t count = pendingCount();
+    if (count == 0) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    auto start = std::chrono::steady_clock::now();
+    bool written = true;
+    if (storage->isWriteThrough()) {
+        SignalBatch batch;
+        SignalFrame stored;
+        for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+            if (pendingMask & (1u << i)) {
+                double value = values[i].load(std::memory_order_relaxed);
+                batch.set(static_cast<SignalId>(i), value);
+                stored.set(static_cast<SignalId>(i), value);
+            }
+        }
+        written = storage->storeBatch(batch);
+        if (written) {
+            markStored(stored);
+        }
+        CSVMap dirty;
+        {
+            std::lock_guard<std::mutex> lock(extrasMutex);
+            for (const auto& key : dirtyExtras) {
+                dirty[key] = extras[key];
+            }
+            dirtyExtras.clear();
+        }
+        std::vector<std::string> failed;
+        for (const auto& [k, v] : dirty) {
+            if (!storage->store(k, v)) {
+                failed.push_back(k);
+                written = false;
+            }
+        }
+        if (!failed.empty()) {
+            // Retried with the signals; a newer value written meanwhile is still dirty anyway
+            std::lock_guard<std::mutex> lock(extrasMutex);
+            dirtyExtras.insert(failed.begin(), failed.end());
+        }
+    } else {
+        SignalFrame frame = readSignals();
+        CSVMap extrasSnapshot;
+        std::unordered_set<std::string> dirty;
+        {
+            std::lock_guard<std::mutex> lock(extrasMutex);
+            extrasSnapshot = extras;
+            dirty.swap(dirtyExtras);
+        }
+        written = storage->persistFrame(frame, extrasSnapshot);
+        if (written) {
+            markStored(frame);
+        } else {
+            std::lock_guard<std::mutex> lock(extrasMutex);
+            dirtyExtras.insert(dirty.begin(), dirty.end());
+        }
+        // Remember our own write so the watcher does not reload it
+        lastSelfWrite = stampFile();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (!written) {
+        // Keep the signals pending and retry after another interval
+        firstPendingNanos = nowNanos();
+        persistFailed = true;
+        return false;
+    }
+
+    int64_t durableNanos = nowNanos();
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        if (pendingMask & (1u << i)) {
+            durableLatency.record(durableNanos - pendingSince[i]);
+        }
+    }
+    pendingMask = 0;
+    firstPendingNanos = 0;
+    persistFailed = false;
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    std::lock_guard<std::mutex> lock(statsMutex);
+    writerStats.flushCount++;
+    writerStats.keysFlushed += count;
+    writerStats.lastFlushMs = elapsedMs;
+    writerStats.totalFlushMs += elapsedMs;
+    if (elapsedMs > writerStats.maxFlushMs) {
+        writerStats.maxFlushMs = elapsedMs;
+    }
+    return true;
+}
+
+void DataHandler::writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        // Sleep until enough commands are queued, a flush is requested or the oldest pending key is due
+        auto deadline = std::chrono::steady_clock::now() + policy.interval;
+        if (firstPendingNanos != 0) {
+            deadline = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(firstPendingNanos)) + policy.interval;
+        }
+        writerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        writerCv.wait_until(lock, deadline, [this] {
+            return stopWriter || flushRequests != flushesDone ||
+                   queue.size() >= wakeThreshold.load(std::memory_order_relaxed);
+        });
+        writerIdle.store(false, std::memory_order_relaxed);
+        bool stop = stopWriter;
+        uint64_t requested = flushRequests;
+        FlushPolicy current = policy;
+        lock.unlock();
+
+        drainQueue();
+        if (stop || requested != flushesDone || isFlushDue(current)) {
+            persistPending();
+        }
+
+        lock.lock();
+        flushesDone = requested;
+        flushDoneCv.notify_all();
+        if (stop) {
+            writerExited = true;
+            flushDoneCv.notify_all();
+            break;
+        }
+    }
+}
+
+DataHandler::FileStamp DataHandler::stampFile() const {
+    FileStamp stamp;
+    struct stat info;
+    if (stat(storage->getPath().c_str(), &info) == 0) {
+        stamp.inode = info.st_ino;
+        stamp.size = info.st_size;
+        stamp.modifiedNanos = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+    }
+    return stamp;
+}
+
+// Apply keys that another program changed in the backing file
+void DataHandler::reloadExternalChange() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (storage->pollsExternalWriters()) {
+        if (!storage->hasExternalChange()) {
+            return;
+        }
+    } else {
+        FileStamp stamp = stampFile();
+        if (stamp == lastSelfWrite) {
+            return;
+        }
+        lastSelfWrite = stamp;
+    }
+    SignalFrame external;
+    CSVMap externalExtras;
+    if (storage->loadFrame(external, externalExtras) && mergeFromStorage(external, externalExtras)) {
+        commit();
+    }
+}
+
+void DataHandler::watchLoop() {
+    const std::string path = storage->getPath();
+    size_t slash = path.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    const std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+    if (storage->pollsExternalWriters()) {
+        // Stores through a mapping raise no inotify event
+        struct pollfd stop = {stopEventFd, POLLIN, 0};
+        while (true) {
+            int ready = poll(&stop, 1, EXTERNAL_POLL_MS);
+            if (ready == -1 && errno == EINTR) continue;
+            if (ready != 0) break;
+            reloadExternalChange();
+        }
+        return;
+    }
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK);
+    if (inotifyFd == -1 || inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        std::cerr << "Failed to watch " << directory << ", external changes will not be detected" << std::endl;
+        if (inotifyFd != -1) close(inotifyFd);
+        return;
+    }
+
+    alignas(struct inotify_event) char buffer[4096];
+    struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopEventFd, POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+
+        bool touched = false;
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                if (event->len > 0 && name == event->name) {
+                    touched = true;
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        if (touched) {
+            reloadExternalChange();
+        }
+    }
+    close(inotifyFd);
+}
@@ -2,54 +2,54 @@
 #include <iomanip>  
 #include <sstream>  
 #include "Display.h"
+#include "BatteryManager.h"
 
-#define ENVIRONMENT_TEMP 35
 #define WARNING_BATTERY_LEVEL 10
 
-int outputPower;
-double updateOdometer;
-double updateBatteryTemp;
-bool isSafetyAction;
-int gasIntensityDisplay;
-int brakeIntensityDisplay;
-
-Display::Display(DashboardController* dashboardController) {
+Display::Display(DashboardController* dashboardController, const VehicleStateChannel* vehicleState) {
     this->dashboardController = dashboardController;
+    this->vehicleState = vehicleState;
     dashboardController->registerObserver(this);
-    std::cout << "Display initialized" << std::endl;
 }
 
 Display::~Display() {
     dashboardController->unregisterObserver(this);
-    std::cout << "Display destroyed" << std::endl;
 }
 
-void Display::update(
-    const uint16_t& speed,
-    const uint16_t& remainingRange,
-    const int& batteryLevel,
-    const int& climateTemp,
-    const int& windLevel,
-    const int& turnSignal,
-    const std::string& driveMode,
-    const bool& isBrake,
-    const bool& isAccelerator,
-    const bool& acStatus
-    ) {
+void Display::update(const DashboardSnapshot& state, uint32_t changed) {
     if (dashboardController == nullptr) {
-        showSpeed(speed);
-        showBatteryLevel(batteryLevel);
-        showClimateStatus(acStatus, climateTemp, windLevel);
-        showDriveMode(driveMode);
-        showRemainingRange(remainingRange);
-        showTurnSignal(turnSignal);
-        showBrakePressed(isBrake);
-        showGasPressed(isAccelerator);
+        // Redraw only the lines whose signals changed
+        if (changed & signalBit(SignalId::VEHICLE_SPEED)) showSpeed(state.speed);
+        if (changed & signalBit(SignalId::BATTERY_LEVEL)) showBatteryLevel(state.batteryLevel);
+        if (changed & (signalBit(SignalId::AC_STATUS) | signalBit(SignalId::AC_CONTROL) | signalBit(SignalId::WIND_LEVEL)))
+            showClimateStatus(state.acStatus, state.climateTemp, state.windLevel);
+        if (changed & signalBit(SignalId::DRIVE_MODE)) showDriveMode(state.driveMode == DriveMode::Mode::SPORT ? "SPORT" : "ECO");
+        if (changed & signalBit(SignalId::ROUTE_PLANNER)) showRemainingRange(state.remainingRange);
+        if (changed & signalBit(SignalId::TURN_SIGNAL)) showTurnSignal(state.turnSignal);
+        if (changed & signalBit(SignalId::BRAKE)) showBrakePressed(state.isBrake);
+        if (changed & signalBit(SignalId::ACCELERATOR)) showGasPressed(state.isAccelerator);
     }
     return;
 }
 
 void Display::updateDisplay() {
+    if (vehicleState != nullptr) {
+        // One snapshot, so speed, battery and pedals always belong to the same tick
+        snapshot = vehicleState->load();
+        const DriverInputs& inputs = snapshot.inputs;
+        std::cout << "----------------------------------------" << std::endl;
+        showSpeed(snapshot.speed);
+        showBatteryLevel(static_cast<int>(snapshot.batteryLevel));
+        showClimateStatus(inputs.acStatus, inputs.acTemp, inputs.windLevel);
+        showDriveMode(inputs.driveMode == DriveMode::Mode::ECO ? "ECO" : "SPORT");
+        showRemainingRange(static_cast<uint16_t>(snapshot.remainingRange));
+        showTurnSignal(inputs.turnSignal);
+        showBrakePressed(inputs.isBrake);
+        showGasPressed(inputs.isAccelerator);
+        std::cout << "----------------------------------------" << std::endl;
+        return;
+    }
+
     std::cout << "----------------------------------------" << std::endl;
     showSpeed(dashboardController->getSpeed());
     showBatteryLevel(dashboardController->getBatteryLevel());
@@ -63,16 +63,16 @@ void Display::updateDisplay() {
 }
 
 void Display::showSpeed(const uint16_t& speed) {
-    if (isSafetyAction) {
+    if (snapshot.isSafetyAction) {
         std::cout << " -- Detected press gas and press brake at the same time --> refer to slow down" << std::endl;
     }
     std::cout << " -- Current speed of vehicle: " << speed << " km/h"
-              << " - Max Power of vehicle: " << outputPower << " kW" << std::endl;
+              << " - Max Power of vehicle: " << snapshot.outputPower << " kW" << std::endl;
 }
 
 void Display::showBatteryLevel(const int& batteryLevel) {
     std::cout << " -- Current battery of vehicle: " << batteryLevel << "%"
-              << " - Current battery temp of vehicle: " << std::setprecision(3) << updateBatteryTemp << "°C - " << "Enviroment Temp: " << ENVIRONMENT_TEMP << "°C" << std::endl;
+              << " - Current battery temp of vehicle: " << std::setprecision(3) << snapshot.batteryTemp << "°C - " << "Enviroment Temp: " << BatteryManager::ENVIRONMENT_TEMP << "°C" << std::endl;
     if (batteryLevel < WARNING_BATTERY_LEVEL) {
         std::cout << "Warning: Battery level is too low!" << std::endl;
     }
@@ -94,10 +94,14 @@ void Display::showDriveMode(const std::string& driveMode) {
 
 void Display::showRemainingRange(const uint16_t& remainingRange) {
     std::ostringstream odometerStream;
-    odometerStream << std::fixed << std::setprecision(2) << updateOdometer;
+    odometerStream << std::fixed << std::setprecision(2) << snapshot.odometer;
     
-    std::cout << " -- Remaining Range of vehicle: " << remainingRange << " km"
-              << " - Range Traveled: " << odometerStream.str() << " km" << std::endl;
+    std::cout << " -- Remaining Range of vehicle: " << remainingRange << " km";
+    if (snapshot.rangeP50 > 0.0) {
+        std::cout << " (P10 " << static_cast<int>(snapshot.rangeP10) << " / P50 " << static_cast<int>(snapshot.rangeP50)
+                  << " / P90 " << static_cast<int>(snapshot.rangeP90) << " km)";
+    }
+    std::cout << " - Range Traveled: " << odometerStream.str() << " km" << std::endl;
 }
 
 void Display::showTurnSignal(const int& turnSignal) {
@@ -109,11 +113,11 @@ void Display::showTurnSignal(const int& turnSignal) {
 
 void Display::showBrakePressed(const bool& isBrake) {
     isBrake ? std::cout << " -- Brake is pressed" << std::endl : std::cout << " -- Brake is released"
-                        << " - Brake Intensity: " << brakeIntensityDisplay << " %" << std::endl;
+                        << " - Brake Intensity: " << snapshot.brakeIntensity << " %" << std::endl;
 }
 
 void Display::showGasPressed(const bool& isAccelerator) {
     isAccelerator ? std::cout << " -- Gas is pressed" << std::endl : std::cout << " -- Gas is released"
-                              << " - Gas Intensity: " << gasIntensityDisplay << " %" << std::endl;
+                              << " - Gas Intensity: " << snapshot.gasIntensity << " %" << std::endl;
 }
     
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "DriveCycle.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+enum class Pedal { ACCELERATE, COAST, BRAKE };
+
+// Segments of one drive mode and AC setting; acTemp 0 is AC off
+class CycleBuilder {
+public:
+    CycleBuilder& mode(DriveMode::Mode driveMode) {
+        inputs.driveMode = driveMode;
+        return *this;
+    }
+
+    CycleBuilder& ac(int acTemp, int windLevel) {
+        inputs.acStatus = acTemp > 0;
+        inputs.acTemp = acTemp;
+        inputs.windLevel = windLevel;
+        return *this;
+    }
+
+    CycleBuilder& add(double seconds, Pedal pedal) {
+        CycleSegment segment{seconds, inputs};
+        segment.inputs.isAccelerator = pedal == Pedal::ACCELERATE;
+        segment.inputs.isBrake = pedal == Pedal::BRAKE;
+        segments.push_back(segment);
+        return *this;
+    }
+
+    // Accelerate, coast, brake to a stop and wait, count times
+    CycleBuilder& stops(int count, double accelerate, double coast, double brake, double wait) {
+        for (int i = 0; i < count; i++) {
+            add(accelerate, Pedal::ACCELERATE).add(coast, Pedal::COAST).add(brake, Pedal::BRAKE);
+            if (wait > 0.0) add(wait, Pedal::BRAKE);
+        }
+        return *this;
+    }
+
+    std::vector<CycleSegment> segments;
+
+private:
+    DriverInputs inputs;
+};
+
+std::vector<DriveCycle> createBuiltIn() {
+    std::vector<DriveCycle> cycles;
+
+    // Short pulls between lights, a long red every fourth stop
+    CycleBuilder urban;
+    urban.ac(22, 2).stops(3, 2.0, 8.0, 5.0, 5.0).stops(1, 2.0, 8.0, 5.0, 30.0);
+    cycles.emplace_back("urban", urban.segments);
+
+    // At the ECO limit with a lift for traffic every ten minutes
+    CycleBuilder highway;
+    highway.ac(21, 3).add(590.0, Pedal::ACCELERATE).add(10.0, Pedal::COAST);
+    cycles.emplace_back("highway", highway.segments);
+
+    // Hard launches and late braking in SPORT, AC off
+    CycleBuilder sport;
+    sport.mode(DriveMode::Mode::SPORT)
+        .add(12.0, Pedal::ACCELERATE).add(4.0, Pedal::BRAKE)
+        .add(6.0, Pedal::ACCELERATE).add(4.0, Pedal::COAST)
+        .add(8.0, Pedal::ACCELERATE).add(6.0, Pedal::BRAKE);
+    cycles.emplace_back("sport", sport.segments);
+
+    // WLTP phases: low 590 s, medium 435 s, high 455 s, extra high 320 s
+    CycleBuilder wltp;
+    wltp.ac(22, 2)
+        .stops(10, 2.0, 20.0, 7.0, 30.0)
+        .stops(5, 4.0, 60.0, 8.0, 15.0)
+        .stops(5, 6.0, 70.0, 6.0, 9.0)
+        .add(8.0, Pedal::ACCELERATE).add(300.0, Pedal::COAST).add(12.0, Pedal::BRAKE);
+    cycles.emplace_back("wltp", wltp.segments);
+    return cycles;
+}
+
+} // namespace
+
+DriveCycle::DriveCycle(const std::string& name, const std::vector<CycleSegment>& segments)
+    : name(name), segments(segments), duration(0.0) {
+    for (const CycleSegment& segment : segments) {
+        duration += segment.duration;
+        ends.push_back(duration);
+    }
+}
+
+const std::vector<DriveCycle>& DriveCycle::builtIn() {
+    static const std::vector<DriveCycle> cycles = createBuiltIn();
+    return cycles;
+}
+
+const DriveCycle* DriveCycle::find(const std::string& name) {
+    for (const DriveCycle& cycle : builtIn()) {
+        if (cycle.getName() == name) return &cycle;
+    }
+    return nullptr;
+}
+
+DriverInputs DriveCycle::inputsAt(double seconds) const {
+    if (segments.empty() || duration <= 0.0) {
+        return DriverInputs();
+    }
+    double offset = std::fmod(std::max(seconds, 0.0), duration);
+    size_t index = std::upper_bound(ends.begin(), ends.end(), offset) - ends.begin();
+    return segments[std::min(index, segments.size() - 1)].inputs;
+}
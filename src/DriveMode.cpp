@@ -1,18 +1,21 @@
 #include "DriveMode.h"
 #include "VehicleConfig.h"
 
-DriveMode::DriveMode() {
+DriveMode::DriveMode() : DriveMode(ElectricVehicleInit::getProfile()) {}
+
+DriveMode::DriveMode(const VehicleProfile& profile) {
     this->currentMode = Mode::ECO;
-    const int MAX_POWER = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_ENGINE_POWER);
+    setProfile(profile);
+}
+
+void DriveMode::setProfile(const VehicleProfile& profile) {
+    const int MAX_POWER = profile.getDesignValue(VehicleAttribute::MAX_ENGINE_POWER);
     DriveModeFactor driveModeFactor;
     powerOutputECO = driveModeFactor.ECO * MAX_POWER;
     powerOutputSport = MAX_POWER;
-    std::cout << "DriveMode initialized" << std::endl;
 }
 
-DriveMode::~DriveMode() {
-    std::cout << "DriveMode destroyed" << std::endl;
-}
+DriveMode::~DriveMode() {}
 
 void DriveMode::setMode(Mode mode) {
     if (mode == Mode::ECO) {
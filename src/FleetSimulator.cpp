@@ -0,0 +1,195 @@
+#include "FleetSimulator.h"
+#include "BatteryManager.h"
+#include "DriveMode.h"
+#include "SafetyManager.h"
+#include "SpeedCalculator.h"
+#include "VehicleConfig.h"
+#include <algorithm>
+
+FleetSimulator::FleetSimulator(size_t vehicleCount, SimulationClock* clock, ThreadPool* pool)
+    : FleetSimulator(vehicleCount, clock, pool, ElectricVehicleInit::getProfile()) {}
+
+FleetSimulator::FleetSimulator(size_t vehicleCount, SimulationClock* clock, ThreadPool* pool, const VehicleProfile& profile)
+    : vehicleCount(vehicleCount), clock(clock), pool(pool),
+      accelerator(vehicleCount, 0), brake(vehicleCount, 0), sport(vehicleCount, 0),
+      acTemp(vehicleCount, 0), windLevel(vehicleCount, 0), environmentTemp(vehicleCount, BatteryManager::ENVIRONMENT_TEMP),
+      activeSport(vehicleCount, 0), ecoModeChanged(vehicleCount, 0),
+      acceleratorIntensity(vehicleCount, 0), brakeIntensity(vehicleCount, 0),
+      speed(vehicleCount, 0), calculatedSpeed(vehicleCount, 0), lastSpeed(vehicleCount, 0),
+      lastDriveMode(vehicleCount, NO_MODE), lastAcceleration(vehicleCount, 0.0),
+      distanceMeters(vehicleCount, 0.0), powerConsumption(vehicleCount, 0.0),
+      drainPerKm(vehicleCount, 0.1), previousDrainPerKm(vehicleCount, 0.1),
+      remainingRange(vehicleCount, 0.0), batteryTemp(vehicleCount, BatteryManager::ENVIRONMENT_TEMP) {
+    maxSpeedEco = profile.getDesignValue(VehicleAttribute::MAX_SPEED_ECO);
+    maxSpeedSport = profile.getDesignValue(VehicleAttribute::MAX_SPEED_SPORT);
+    vehicleWeight = profile.getDesignValue(VehicleAttribute::WEIGHT);
+    batteryMaxCapacity = profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    maxRange = profile.getDesignValue(VehicleAttribute::MAX_RANGE);
+    maxAcPower = profile.getDesignValue(VehicleAttribute::MAX_AC_POWER);
+    tables = profile.tables;
+
+    totalWeight.assign(vehicleCount, vehicleWeight + SpeedCalculator::LOAD);
+    currentKwH.assign(vehicleCount, batteryMaxCapacity);
+    batteryLevel.assign(vehicleCount, 100.0);
+}
+
+void FleetSimulator::setEnvironment(size_t vehicle, double environmentTemp, int load) {
+    this->environmentTemp[vehicle] = environmentTemp;
+    totalWeight[vehicle] = vehicleWeight + load;
+}
+
+void FleetSimulator::resetVehicle(size_t vehicle, int speed, double kwh) {
+    activeSport[vehicle] = sport[vehicle];
+    ecoModeChanged[vehicle] = 0;
+    acceleratorIntensity[vehicle] = 0;
+    brakeIntensity[vehicle] = 0;
+    this->speed[vehicle] = speed;
+    calculatedSpeed[vehicle] = speed;
+    lastSpeed[vehicle] = speed;
+    lastDriveMode[vehicle] = NO_MODE;
+    lastAcceleration[vehicle] = 0.0;
+    distanceMeters[vehicle] = 0.0;
+    powerConsumption[vehicle] = 0.0;
+    currentKwH[vehicle] = std::min(std::max(kwh, 0.0), batteryMaxCapacity);
+    batteryLevel[vehicle] = currentKwH[vehicle] / batteryMaxCapacity * 100.0;
+    drainPerKm[vehicle] = 0.1;
+    previousDrainPerKm[vehicle] = 0.1;
+    remainingRange[vehicle] = 0.0;
+    batteryTemp[vehicle] = environmentTemp[vehicle];
+}
+
+void FleetSimulator::setInputs(size_t vehicle, const DriverInputs& inputs) {
+    accelerator[vehicle] = inputs.isAccelerator;
+    brake[vehicle] = inputs.isBrake;
+    sport[vehicle] = inputs.driveMode == DriveMode::Mode::SPORT;
+    acTemp[vehicle] = inputs.acTemp;
+    windLevel[vehicle] = inputs.windLevel;
+}
+
+void FleetSimulator::step() {
+    pool->parallelFor(vehicleCount, GRAIN, [this](size_t begin, size_t end) { stepRange(begin, end); });
+}
+
+void FleetSimulator::stepRange(size_t begin, size_t end) {
+    double deltaTime = clock->getDeltaTime();
+    for (size_t i = begin; i < end; i++) {
+        if (sport[i] != activeSport[i]) {
+            activeSport[i] = sport[i];
+            ecoModeChanged[i] = !sport[i];
+        }
+
+        updateBattery(i, deltaTime);
+
+        if (ecoModeChanged[i]) {
+            if (speed[i] > maxSpeedEco) {
+                speed[i] = static_cast<int>(speed[i] * 0.9);    // DriveMode::limitSpeedECO
+            } else {
+                ecoModeChanged[i] = 0;
+            }
+        } else {
+            updateSpeed(i, deltaTime);
+            speed[i] = calculatedSpeed[i];
+        }
+
+        // SafetyManager::isBrakeAndAcceleratorCoincidence
+        if (accelerator[i] && brake[i]) {
+            brakeIntensity[i] = std::min(brakeIntensity[i] + 10, SafetyManager::MAX_PEDAL);
+            acceleratorIntensity[i] = 0;
+        }
+    }
+}
+
+// BatteryManager::updateBatteryCapacity, calculateRemainingRange and calculateBatteryTemp
+void FleetSimulator::updateBattery(size_t i, double deltaTime) {
+    int acPower = VehicleCalculator::getPowerAC(environmentTemp[i], acTemp[i], maxAcPower);
+    int windPower = VehicleCalculator::getPowerWind(windLevel[i]);
+    double drainKwHPerSecond = (powerConsumption[i] + acPower + windPower) / 1000.0 / 3600.0;
+
+    double kwh = currentKwH[i] - drainKwHPerSecond * deltaTime;
+    if (kwh < 0) kwh = 0;
+    currentKwH[i] = kwh;
+    batteryLevel[i] = (kwh / batteryMaxCapacity) * 100.0;
+
+    double drain;
+    double travelledKm = distanceMeters[i] / 1000.0;
+    if (travelledKm > 0.1) {
+        drain = (batteryMaxCapacity - kwh) / travelledKm;
+        drain = 0.9 * previousDrainPerKm[i] + 0.1 * drain;
+        previousDrainPerKm[i] = drain;
+    } else {
+        drain = batteryMaxCapacity / maxRange;
+    }
+    if (drain < 0.001) drain = 0.1;
+    drainPerKm[i] = drain;
+
+    double range = kwh / drain;
+    remainingRange[i] = range > maxRange ? maxRange : range;
+    batteryTemp[i] = VehicleCalculator::getBatteryTemp(batteryTemp[i], environmentTemp[i], powerConsumption[i]);
+}
+
+// SpeedCalculator::calculateSpeed
+void FleetSimulator::updateSpeed(size_t i, double deltaTime) {
+    // Pedal intensities (SafetyManager)
+    int gas = acceleratorIntensity[i];
+    int brakeLevel = brakeIntensity[i];
+    if (accelerator[i] && !brake[i]) {
+        gas = std::min(gas + 1, SafetyManager::MAX_PEDAL);
+        brakeLevel = 0;
+    } else if (!accelerator[i] && brake[i]) {
+        brakeLevel = std::min(brakeLevel + 10, SafetyManager::MAX_PEDAL);
+        gas = 0;
+    } else {
+        brakeLevel = std::max(0, brakeLevel - 10);
+        gas = std::max(0, gas - 1);
+    }
+    acceleratorIntensity[i] = gas;
+    brakeIntensity[i] = brakeLevel;
+
+    double speedMetersPerSecond = calculatedSpeed[i] / 3.6;
+    double traction;
+    tables->atSpeed(speedMetersPerSecond, gas, traction, powerConsumption[i]);
+    double acceleration = VehicleCalculator::getAcceleration(speedMetersPerSecond, traction, totalWeight[i], brakeLevel,
+                                                             lastAcceleration[i]);
+    speedMetersPerSecond += acceleration * deltaTime;
+    if (speedMetersPerSecond < 0) speedMetersPerSecond = 0;
+
+    int current = static_cast<int>(speedMetersPerSecond * 3.6);
+    int8_t mode = activeSport[i];
+    if (accelerator[i]) {
+        // SpeedCalculator::adjustSpeedForDriveMode
+        DriveModeFactor driveModeFactor;
+        int preAdjustSpeed = current;
+        bool driveModeChanged = lastDriveMode[i] != NO_MODE && lastDriveMode[i] != mode;
+        if (driveModeChanged && !mode && current > maxSpeedEco) {
+            current = maxSpeedEco;
+            lastSpeed[i] = current;
+        }
+
+        int speedIncrement = preAdjustSpeed - lastSpeed[i];
+        if (speedIncrement > 0) {
+            current = lastSpeed[i] + (speedIncrement * (mode ? driveModeFactor.SPORT : driveModeFactor.ECO));
+        }
+        int maxSpeed = mode ? maxSpeedSport : maxSpeedEco;
+        if (current > maxSpeed) current = maxSpeed;
+
+        if (!driveModeChanged && current < lastSpeed[i]) {
+            current = lastSpeed[i];
+        }
+        lastSpeed[i] = current;
+        lastDriveMode[i] = mode;
+    } else {
+        int maxSpeed = mode ? maxSpeedSport : maxSpeedEco;
+        if (current > maxSpeed) current = maxSpeed;
+    }
+    calculatedSpeed[i] = current;
+
+    distanceMeters[i] += speedMetersPerSecond * deltaTime + 0.5 * acceleration * deltaTime * deltaTime;
+}
+
+double FleetSimulator::getTotalKwH() const {
+    double total = 0.0;
+    for (double kwh : currentKwH) {
+        total += kwh;
+    }
+    return total;
+}
@@ -0,0 +1,26 @@
+#include "Integrator.h"
+
+Integrator::Integrator(IntegratorMethod method, double tolerance, double maxStep)
+    : method(method), tolerance(tolerance > 0.0 ? tolerance : DEFAULT_TOLERANCE),
+      maxStep(maxStep > 0.0 ? maxStep : DEFAULT_MAX_STEP), nextStep(this->maxStep) {}
+
+const char* Integrator::methodName(IntegratorMethod method) {
+    switch (method) {
+        case IntegratorMethod::EULER:               return "euler";
+        case IntegratorMethod::SEMI_IMPLICIT_EULER: return "semi-implicit";
+        case IntegratorMethod::RK4:                 return "rk4";
+        case IntegratorMethod::RK45:                return "rk45";
+    }
+    return "unknown";
+}
+
+bool Integrator::parseMethod(const std::string& name, IntegratorMethod& method) {
+    for (IntegratorMethod candidate : {IntegratorMethod::EULER, IntegratorMethod::SEMI_IMPLICIT_EULER,
+                                       IntegratorMethod::RK4, IntegratorMethod::RK45}) {
+        if (name == methodName(candidate)) {
+            method = candidate;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,268 @@
+#include "JournalStorage.h"
+#include "Crc32.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define RECORD_HEADER_SIZE 6   // crc32 + key length + value length
+#define MAX_FIELD_LENGTH 255
+
+static bool fileExists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+JournalStorage::JournalStorage(const std::string& snapshotPath, const std::string& journalPath,
+                               size_t compactThresholdBytes, bool compactInBackground)
+    : snapshotPath(snapshotPath), journalPath(journalPath), rotatedPath(journalPath + ".old"),
+      compactThreshold(compactThresholdBytes), stopCompactor(false), compactRequested(false),
+      fd(-1), journalBytes(0), recovered(false), recoveredRecords(0), compactionCount(0) {
+    recovered = recover();
+    openJournal();
+    if (compactInBackground) {
+        compactor = std::thread(&JournalStorage::compactLoop, this);
+    }
+}
+
+JournalStorage::~JournalStorage() {
+    {
+        std::lock_guard<std::mutex> lock(journalMutex);
+        stopCompactor = true;
+    }
+    compactCv.notify_one();
+    if (compactor.joinable()) {
+        compactor.join();
+    }
+    sync();
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+// Snapshot first, then the rotated journal of an interrupted compaction, then the active journal
+bool JournalStorage::recover() {
+    bool hadJournal = fileExists(journalPath) || fileExists(rotatedPath);
+    state = CsvStorage(snapshotPath).load();
+    if (fileExists(rotatedPath)) {
+        recoveredRecords += replay(rotatedPath, false);
+    }
+    if (fileExists(journalPath)) {
+        recoveredRecords += replay(journalPath, true);
+    }
+    if (hadJournal) {
+        std::cout << "Journal recovery: replayed " << recoveredRecords << " records" << std::endl;
+    }
+    // Finish an interrupted compaction before the rotated journal can be overwritten
+    if (fileExists(rotatedPath) && writeSnapshot(state)) {
+        std::remove(rotatedPath.c_str());
+    }
+    return hadJournal;
+}
+
+size_t JournalStorage::replay(const std::string& path, bool truncateTornTail) {
+    std::ifstream infile(path, std::ios::binary);
+    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    size_t records = 0;
+    while (offset + RECORD_HEADER_SIZE <= buffer.size()) {
+        const uint8_t* record = buffer.data() + offset;
+        uint32_t storedCrc = record[0] | (record[1] << 8) | (record[2] << 16) | (static_cast<uint32_t>(record[3]) << 24);
+        size_t keyLength = record[4];
+        size_t valueLength = record[5];
+        size_t recordSize = RECORD_HEADER_SIZE + keyLength + valueLength;
+        if (offset + recordSize > buffer.size() || crc32(record + 4, recordSize - 4) != storedCrc) {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char*>(record + RECORD_HEADER_SIZE), keyLength);
+        std::string value(reinterpret_cast<const char*>(record + RECORD_HEADER_SIZE + keyLength), valueLength);
+        state[key] = value;
+        offset += recordSize;
+        records++;
+    }
+
+    if (offset < buffer.size()) {
+        std::cerr << "Journal " << path << ": discarding " << (buffer.size() - offset) << " bytes of torn tail" << std::endl;
+        if (truncateTornTail && truncate(path.c_str(), offset) == -1) {
+            std::cerr << "Failed to truncate journal: " << path << std::endl;
+        }
+    }
+    if (truncateTornTail) {
+        journalBytes = offset;
+    }
+    return records;
+}
+
+bool JournalStorage::openJournal() {
+    fd = open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd == -1) {
+        std::cerr << "Failed to open journal: " << journalPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+CSVMap JournalStorage::load() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    return state;
+}
+
+// Encode one record into out, returns its size or 0 if a field is too long
+static size_t encodeRecord(const std::string& key, const std::string& value, uint8_t* out) {
+    if (key.size() > MAX_FIELD_LENGTH || value.size() > MAX_FIELD_LENGTH) {
+        std::cerr << "Journal record too long for key: " << key << std::endl;
+        return 0;
+    }
+    size_t recordSize = RECORD_HEADER_SIZE + key.size() + value.size();
+    out[4] = static_cast<uint8_t>(key.size());
+    out[5] = static_cast<uint8_t>(value.size());
+    std::copy(key.begin(), key.end(), out + RECORD_HEADER_SIZE);
+    std::copy(value.begin(), value.end(), out + RECORD_HEADER_SIZE + key.size());
+    uint32_t crc = crc32(out + 4, recordSize - 4);
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(crc >> (8 * i));
+    }
+    return recordSize;
+}
+
+bool JournalStorage::append(const uint8_t* records, size_t size, const CSVMap& applied) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (fd == -1 || write(fd, records, size) != static_cast<ssize_t>(size)) {
+        std::cerr << "Failed to append to journal: " << journalPath << std::endl;
+        return false;
+    }
+    for (const auto& [k, v] : applied) {
+        state[k] = v;
+    }
+    journalBytes += size;
+    if (journalBytes >= compactThreshold && !compactRequested) {
+        compactRequested = true;
+        compactCv.notify_one();
+    }
+    return true;
+}
+
+bool JournalStorage::store(const std::string& key, const std::string& value) {
+    uint8_t record[RECORD_HEADER_SIZE + 2 * MAX_FIELD_LENGTH];
+    size_t recordSize = encodeRecord(key, value, record);
+    if (recordSize == 0) {
+        return false;
+    }
+    return append(record, recordSize, {{key, value}});
+}
+
+bool JournalStorage::storeBatch(const SignalBatch& batch) {
+    uint8_t records[SIGNAL_COUNT * (RECORD_HEADER_SIZE + 2 * MAX_FIELD_LENGTH)];
+    size_t size = 0;
+    CSVMap applied;
+    for (const auto& update : batch) {
+        const std::string key = signalInfo(update.id).csvName;
+        const std::string value = formatSignal(update.id, update.value);
+        size_t recordSize = encodeRecord(key, value, records + size);
+        if (recordSize == 0) {
+            return false;
+        }
+        size += recordSize;
+        applied[key] = value;
+    }
+    return size == 0 || append(records, size, applied);
+}
+
+bool JournalStorage::persist(const CSVMap& data) {
+    for (const auto& [k, v] : data) {
+        if (!store(k, v)) return false;
+    }
+    return true;
+}
+
+void JournalStorage::sync() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (fd != -1) {
+        fdatasync(fd);
+    }
+}
+
+bool JournalStorage::writeSnapshot(const CSVMap& snapshot) {
+    const std::string tempPath = snapshotPath + ".tmp";
+    if (!CsvStorage(tempPath).persist(snapshot)) {
+        return false;
+    }
+    int tempFd = open(tempPath.c_str(), O_RDONLY);
+    if (tempFd != -1) {
+        fsync(tempFd);
+        close(tempFd);
+    }
+    if (std::rename(tempPath.c_str(), snapshotPath.c_str()) != 0) {
+        std::cerr << "Failed to install snapshot: " << snapshotPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool JournalStorage::compact() {
+    CSVMap snapshot;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex);
+        compactRequested = false;
+        // A rotated journal left by a failed compaction must not be overwritten:
+        // only retry its snapshot and rotate on the next round
+        if (!fileExists(rotatedPath)) {
+            // Rotate the journal: everything in the rotated file is covered by this snapshot
+            if (fd != -1) {
+                fdatasync(fd);
+                close(fd);
+                fd = -1;
+            }
+            if (std::rename(journalPath.c_str(), rotatedPath.c_str()) != 0) {
+                std::cerr << "Failed to rotate journal: " << journalPath << std::endl;
+                openJournal();
+                return false;
+            }
+            openJournal();
+            journalBytes = 0;
+        }
+        snapshot = state;
+    }
+
+    if (!writeSnapshot(snapshot)) {
+        return false;
+    }
+    std::remove(rotatedPath.c_str());
+
+    std::lock_guard<std::mutex> lock(journalMutex);
+    compactionCount++;
+    return true;
+}
+
+void JournalStorage::maintain() {
+    if (compactor.joinable()) {
+        return;     // the compactor thread does it
+    }
+    bool requested;
+    {
+        std::lock_guard<std::mutex> lock(journalMutex);
+        requested = compactRequested;
+    }
+    if (requested) {
+        compact();
+    }
+}
+
+void JournalStorage::compactLoop() {
+    std::unique_lock<std::mutex> lock(journalMutex);
+    while (true) {
+        compactCv.wait(lock, [this] { return stopCompactor || compactRequested; });
+        if (stopCompactor) {
+            break;
+        }
+        lock.unlock();
+        compact();
+        lock.lock();
+    }
+}
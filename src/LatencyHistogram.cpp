@@ -0,0 +1,63 @@
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    uint64_t micros = nanoseconds / 1000;
+    size_t bucket = 0;
+    while (micros > 0 && bucket < BUCKET_COUNT - 1) {
+        micros >>= 1;
+        bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    totalNanos.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t previousMax = maxNanos.load(std::memory_order_relaxed);
+    while (nanoseconds > previousMax && !maxNanos.compare_exchange_weak(previousMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    totalNanos.store(0, std::memory_order_relaxed);
+    maxNanos.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMeanMicros() const {
+    uint64_t samples = getCount();
+    if (samples == 0) return 0.0;
+    return totalNanos.load(std::memory_order_relaxed) / 1000.0 / samples;
+}
+
+double LatencyHistogram::getPercentileMicros(double percentile) const {
+    uint64_t samples = getCount();
+    if (samples == 0) return 0.0;
+
+    uint64_t target = static_cast<uint64_t>(samples * percentile / 100.0);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return static_cast<double>(1ULL << i);
+        }
+    }
+    return getMaxMicros();
+}
+
+void LatencyHistogram::print(std::ostream& out, const std::string& title) const {
+    out << title << ": " << getCount() << " samples, mean " << getMeanMicros() << " us, p50 <= "
+        << getPercentileMicros(50) << " us, p99 <= " << getPercentileMicros(99) << " us, max "
+        << getMaxMicros() << " us" << std::endl;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        uint64_t samples = buckets[i].load(std::memory_order_relaxed);
+        if (samples == 0) continue;
+        out << "  < " << (1ULL << i) << " us: " << samples << std::endl;
+    }
+}
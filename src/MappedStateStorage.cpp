@@ -0,0 +1,222 @@
+#include "MappedStateStorage.h"
+#include <iostream>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const size_t MAPPED_FILE_SIZE = sizeof(MappedStateHeader) + SIGNAL_COUNT * sizeof(MappedStateSlot);
+
+static uint64_t toWord(double value) {
+    uint64_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+static double fromWord(uint64_t word) {
+    double value;
+    std::memcpy(&value, &word, sizeof(value));
+    return value;
+}
+
+static bool isValidHeader(const MappedStateHeader* header) {
+    return std::memcmp(header->magic, MAPPED_STATE_MAGIC, sizeof(MAPPED_STATE_MAGIC)) == 0
+        && header->version == MAPPED_STATE_VERSION
+        && header->slotCount == SIGNAL_COUNT;
+}
+
+MappedStateStorage::MappedStateStorage(const std::string& path, const std::string& importCsv)
+    : path(path), fd(-1), mappedSize(MAPPED_FILE_SIZE), header(nullptr), slots(nullptr), seenGeneration(0),
+      externalStore(false) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd == -1) {
+        std::cerr << "Failed to open state file: " << path << std::endl;
+        return;
+    }
+
+    struct stat info;
+    bool fresh = (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) != mappedSize);
+    if (fresh && ftruncate(fd, mappedSize) == -1) {
+        std::cerr << "Failed to size state file: " << path << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Failed to map state file: " << path << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+    header = static_cast<MappedStateHeader*>(memory);
+    slots = reinterpret_cast<MappedStateSlot*>(header + 1);
+
+    if (fresh || !isValidHeader(header)) {
+        // Lay out an empty file and seed it from the CSV import file
+        std::memset(memory, 0, mappedSize);
+        std::memcpy(header->magic, MAPPED_STATE_MAGIC, sizeof(MAPPED_STATE_MAGIC));
+        header->version = MAPPED_STATE_VERSION;
+        header->slotCount = SIGNAL_COUNT;
+        persist(CsvStorage(importCsv).load());
+        std::cout << "State file " << path << " imported from " << importCsv << std::endl;
+    }
+    seenGeneration = __atomic_load_n(&header->generation, __ATOMIC_ACQUIRE);
+    externalStore = false;
+}
+
+MappedStateStorage::~MappedStateStorage() {
+    if (header != nullptr) {
+        sync();
+        munmap(header, mappedSize);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+CSVMap MappedStateStorage::load() {
+    CSVMap data;
+    if (header == nullptr) return data;
+
+    uint64_t present = __atomic_load_n(&header->presentMask, __ATOMIC_ACQUIRE);
+    for (const auto& info : SIGNALS) {
+        size_t index = signalIndex(info.id);
+        if (present & (1ULL << index)) {
+            double value = fromWord(__atomic_load_n(&slots[index].word, __ATOMIC_ACQUIRE));
+            data[info.csvName] = formatSignal(info.id, value);
+        }
+    }
+    return data;
+}
+
+bool MappedStateStorage::persist(const CSVMap& data) {
+    bool stored = true;
+    SignalId id;
+    for (const auto& [k, v] : data) {
+        if (findSignal(k, id)) {
+            stored = store(k, v) && stored;
+        }
+    }
+    return stored;
+}
+
+bool MappedStateStorage::store(const std::string& key, const std::string& value) {
+    SignalId id;
+    double number;
+    if (!findSignal(key, id)) return false;
+    if (!parseSignal(id, value, number)) {
+        std::cerr << "Invalid value for " << key << ": " << value << std::endl;
+        return false;
+    }
+    return storeSignal(id, number);
+}
+
+bool MappedStateStorage::storeSignal(SignalId id, double value) {
+    if (header == nullptr) return false;
+
+    size_t index = signalIndex(id);
+    __atomic_store_n(&slots[index].word, toWord(value), __ATOMIC_RELEASE);
+    __atomic_fetch_or(&header->presentMask, 1ULL << index, __ATOMIC_RELEASE);
+    uint64_t generation = __atomic_add_fetch(&header->generation, 1, __ATOMIC_RELEASE);
+    if (generation != seenGeneration + 1) {
+        externalStore = true;
+    }
+    seenGeneration = generation;
+    return true;
+}
+
+bool MappedStateStorage::hasExternalChange() {
+    if (header == nullptr) return false;
+    uint64_t generation = __atomic_load_n(&header->generation, __ATOMIC_ACQUIRE);
+    bool changed = externalStore || generation != seenGeneration;
+    seenGeneration = generation;
+    externalStore = false;
+    return changed;
+}
+
+void MappedStateStorage::sync() {
+    if (header != nullptr) {
+        msync(header, mappedSize, MS_SYNC);
+    }
+}
+
+MappedStateView::MappedStateView(const std::string& path)
+    : fd(-1), mappedSize(MAPPED_FILE_SIZE), header(nullptr), slots(nullptr) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Failed to open state file: " << path << std::endl;
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) != mappedSize) {
+        std::cerr << "Unexpected state file size: " << path << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    void* memory = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Failed to map state file: " << path << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+    header = static_cast<const MappedStateHeader*>(memory);
+    if (!isValidHeader(header)) {
+        std::cerr << "Incompatible state file: " << path << std::endl;
+        munmap(memory, mappedSize);
+        header = nullptr;
+        return;
+    }
+    slots = reinterpret_cast<const MappedStateSlot*>(header + 1);
+}
+
+MappedStateView::~MappedStateView() {
+    if (header != nullptr) {
+        munmap(const_cast<MappedStateHeader*>(header), mappedSize);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+uint64_t MappedStateView::getGeneration() const {
+    if (header == nullptr) return 0;
+    return __atomic_load_n(&header->generation, __ATOMIC_ACQUIRE);
+}
+
+bool MappedStateView::readSignal(SignalId id, double& value) const {
+    if (header == nullptr) return false;
+    size_t index = signalIndex(id);
+    uint64_t present = __atomic_load_n(&header->presentMask, __ATOMIC_ACQUIRE);
+    if (!(present & (1ULL << index))) return false;
+    value = fromWord(__atomic_load_n(&slots[index].word, __ATOMIC_ACQUIRE));
+    return true;
+}
+
+SignalFrame MappedStateView::readFrame() const {
+    SignalFrame frame;
+    double value;
+    for (const auto& info : SIGNALS) {
+        if (readSignal(info.id, value)) {
+            frame.set(info.id, value);
+        }
+    }
+    return frame;
+}
+
+CSVMap MappedStateView::readAll() const {
+    CSVMap data;
+    double value;
+    for (const auto& info : SIGNALS) {
+        if (readSignal(info.id, value)) {
+            data[info.csvName] = formatSignal(info.id, value);
+        }
+    }
+    return data;
+}
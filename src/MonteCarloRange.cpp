@@ -0,0 +1,187 @@
+#include "MonteCarloRange.h"
+#include "BatteryManager.h"
+#include "DriveMode.h"
+#include "RandomStream.h"
+#include <algorithm>
+#include <cmath>
+
+MonteCarloRange::MonteCarloRange(const VehicleProfile& profile, size_t sampleCount, ThreadPool* pool, uint64_t seed)
+    : clock(SimulationClock::Mode::FIXED_STEP), fleet(std::max<size_t>(sampleCount, 1), &clock, pool, profile),
+      pool(pool), seed(seed), consumption(std::max<size_t>(sampleCount, 1), 0.0),
+      generation(std::max<size_t>(sampleCount, 1), 0), nextSample(0), filled(0), simulations(0), accelerating(false),
+      sincePress(0.0), refreshing(false), refreshPending(false), stopping(false), pendingCount(0) {
+    clock.tick();
+    batteryMaxCapacity = profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    maxRange = profile.getDesignValue(VehicleAttribute::MAX_RANGE);
+    acTempMin = profile.getDesignValue(VehicleAttribute::AC_TEMP_MIN);
+    acTempMax = profile.getDesignValue(VehicleAttribute::AC_TEMP_MAX);
+    windLevelMax = profile.getDesignValue(VehicleAttribute::WIND_LEVEL_MAX);
+}
+
+MonteCarloRange::~MonteCarloRange() {
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex);
+        stopping = true;
+    }
+    refreshCv.notify_one();
+    if (refresher.joinable()) {
+        refresher.join();
+    }
+}
+
+void MonteCarloRange::observe(const DriverInputs& inputs, int speed, double deltaTime) {
+    Style& style = observed.style;
+    double weight = std::min(deltaTime / STYLE_SECONDS, 1.0);
+    style.throttle += weight * (inputs.isAccelerator - style.throttle);
+    style.brake += weight * (inputs.isBrake - style.brake);
+    style.sport += weight * ((inputs.driveMode == DriveMode::Mode::SPORT) - style.sport);
+
+    // Cycle length from press to press; a held pedal leaves it alone
+    sincePress = std::min(sincePress + deltaTime, HORIZON_SECONDS);
+    if (inputs.isAccelerator && !accelerating) {
+        style.period += 0.1 * (sincePress - style.period);
+        sincePress = 0.0;
+    }
+    accelerating = inputs.isAccelerator;
+    observed.current = inputs;
+    observed.currentSpeed = speed;
+}
+
+// Not while a slice started by refreshAsync() runs
+void MonteCarloRange::refresh(size_t count) {
+    runSlice(count, observed);
+}
+
+bool MonteCarloRange::refreshAsync(size_t count) {
+    if (refreshing.load(std::memory_order_acquire)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex);
+        pendingCount = count;
+        pending = observed;
+        refreshPending = true;
+        refreshing.store(true, std::memory_order_release);
+        if (!refresher.joinable()) {
+            refresher = std::thread(&MonteCarloRange::refreshLoop, this);
+        }
+    }
+    refreshCv.notify_one();
+    return true;
+}
+
+void MonteCarloRange::refreshLoop() {
+    std::unique_lock<std::mutex> lock(refreshMutex);
+    while (true) {
+        refreshCv.wait(lock, [this] { return stopping || refreshPending; });
+        if (stopping) {
+            return;
+        }
+        refreshPending = false;
+        size_t count = pendingCount;
+        Observed start = pending;
+        lock.unlock();
+        runSlice(count, start);
+        lock.lock();
+        refreshing.store(false, std::memory_order_release);
+    }
+}
+
+void MonteCarloRange::runSlice(size_t count, const Observed& start) {
+    size_t samples = consumption.size();
+    count = std::min(count, samples);
+    if (count == 0) {
+        return;
+    }
+    size_t first = nextSample;
+    pool->parallelFor(count, GRAIN, [this, first, samples, &start](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            simulate((first + k) % samples, start);
+        }
+    });
+    nextSample = (first + count) % samples;
+    filled = std::min(filled + count, samples);
+    simulations.fetch_add(count, std::memory_order_relaxed);
+    publishQuantiles();
+}
+
+// One sample: draw its conditions, drive HORIZON_SECONDS from the current speed, keep kWh/km
+void MonteCarloRange::simulate(size_t sample, const Observed& start) {
+    const Style& base = start.style;
+    size_t samples = consumption.size();
+    RandomStream random(seed, generation[sample]++ * samples + sample);
+
+    double environmentTemp = std::min(std::max(BatteryManager::ENVIRONMENT_TEMP + 4.0 * random.normal(), 15.0), 50.0);
+    int load = static_cast<int>(std::min(std::max(SpeedCalculator::LOAD + 100.0 * random.normal(), 0.0), 600.0));
+    DriverInputs inputs = start.current;
+    if (inputs.acTemp > 0) {
+        inputs.acTemp = std::min(std::max(inputs.acTemp + static_cast<int>(std::lround(random.normal())), acTempMin),
+                                 acTempMax);
+    }
+    if (inputs.windLevel > 0) {
+        inputs.windLevel = std::min(std::max(inputs.windLevel + static_cast<int>(random.uniform() * 3.0) - 1, 1),
+                                    windLevelMax);
+    }
+    double period = std::min(std::max(base.period * std::exp(0.3 * random.normal()), 10.0), HORIZON_SECONDS);
+    double throttle = std::min(std::max(base.throttle * std::exp(0.25 * random.normal()), 0.02), 1.0);
+    double brake = std::min(base.brake * std::exp(0.25 * random.normal()), 1.0 - throttle);
+    inputs.driveMode = random.uniform() < base.sport ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    double phase = random.uniform() * period;
+
+    // Accelerate for the throttle share of each cycle, brake for the brake share at its end
+    auto pedals = [&](double seconds) {
+        double position = std::fmod(seconds + phase, period);
+        inputs.isAccelerator = position < throttle * period;
+        inputs.isBrake = position >= (1.0 - brake) * period;
+    };
+    pedals(0.0);
+    fleet.setInputs(sample, inputs);
+    fleet.setEnvironment(sample, environmentTemp, load);
+    fleet.resetVehicle(sample, start.currentSpeed, batteryMaxCapacity);
+
+    double step = clock.getDeltaTime();
+    int ticks = static_cast<int>(HORIZON_SECONDS / step);
+    for (int tick = 0; tick < ticks; tick++) {
+        pedals(tick * step);
+        fleet.setInputs(sample, inputs);
+        fleet.stepRange(sample, sample + 1);
+    }
+    double energy = batteryMaxCapacity - fleet.getKwH(sample);
+    consumption[sample] = energy / std::max(fleet.getOdometer(sample), 0.01);
+}
+
+// Low consumption is long range: the P90 range comes from the P10 consumption
+void MonteCarloRange::publishQuantiles() {
+    std::vector<double> sorted;
+    for (size_t i = 0; i < consumption.size(); i++) {
+        if (generation[i] > 0) sorted.push_back(consumption[i]);
+    }
+    auto quantile = [&sorted](double p) {
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    };
+    Quantiles result;
+    result.p10 = quantile(0.1);
+    result.p50 = quantile(0.5);
+    result.p90 = quantile(0.9);
+    result.filled = filled;
+    quantiles.store(result);
+}
+
+RangePercentiles MonteCarloRange::estimate(double currentKwH) const {
+    Quantiles consumptionQuantiles = quantiles.load();
+    RangePercentiles result;
+    result.samples = consumptionQuantiles.filled;
+    if (result.samples == 0) {
+        return result;
+    }
+    auto range = [this, currentKwH](double kwhPerKm) {
+        double km = kwhPerKm > 0.0 ? std::max(currentKwH, 0.0) / kwhPerKm : maxRange;
+        return std::min(km, static_cast<double>(maxRange));
+    };
+    result.p10 = range(consumptionQuantiles.p90);
+    result.p50 = range(consumptionQuantiles.p50);
+    result.p90 = range(consumptionQuantiles.p10);
+    return result;
+}
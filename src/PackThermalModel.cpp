@@ -0,0 +1,94 @@
+#include "PackThermalModel.h"
+#include "VehicleKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+PackThermalModel::PackThermalModel(const PackThermalConfig& config) : config(config), heatPower(0.0) {
+    int cellCount = std::max(config.cellCount, 1);
+    columns = config.columns;
+    if (columns <= 0 || cellCount % columns != 0) {
+        std::cerr << "Pack of " << cellCount << " cells does not split into rows of " << columns
+                  << ", using a single row" << std::endl;
+        columns = cellCount;
+    }
+    rows = cellCount / columns;
+    stride = static_cast<size_t>(columns) + 2;
+
+    size_t size = (static_cast<size_t>(rows) + 2) * stride;
+    temp.assign(size, config.coolantTemp);
+    next.assign(size, config.coolantTemp);
+    heat.assign(size, 0.0);
+    cooling.assign(size, 0.0);
+
+    // Fixed cell-to-cell resistance pattern, the same for every run
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    totalResistance = 0.0;
+    double maxCooling = 0.0;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            double variation = 2.0 * static_cast<double>(state >> 11) / 9007199254740992.0 - 1.0;
+            double resistance = config.cellResistance * (1.0 + config.resistanceSpread * variation);
+            double path = columns > 1 ? static_cast<double>(c) / (columns - 1) : 0.0;
+            double conductance = config.coolingConductance * (1.0 - (1.0 - config.outletCooling) * path);
+
+            size_t i = (r + 1) * stride + c + 1;
+            heat[i] = resistance / config.cellHeatCapacity;
+            cooling[i] = conductance / config.cellHeatCapacity;
+            totalResistance += resistance;
+            maxCooling = std::max(maxCooling, cooling[i]);
+        }
+    }
+    conduction = config.neighbourConductance / config.cellHeatCapacity;
+    maxRate = 4.0 * conduction + maxCooling;
+    packVoltage = config.cellVoltage * cellCount;
+    updateStats();
+}
+
+void PackThermalModel::update(double packPowerW, double deltaTime) {
+    if (deltaTime <= 0.0) {
+        return;
+    }
+    double current = packVoltage > 0.0 ? packPowerW / packVoltage : 0.0;
+    heatPower = current * current * totalResistance;
+
+    int steps = std::max(1, static_cast<int>(std::ceil(deltaTime * maxRate / STABLE_FRACTION)));
+    double h = deltaTime / steps;
+    size_t first = stride;
+    size_t count = static_cast<size_t>(rows) * stride;  // the ghost columns are computed and then overwritten
+    for (int s = 0; s < steps; s++) {
+        VehicleKernels::cellTemp(temp.data() + first, heat.data() + first, cooling.data() + first, count, stride,
+                                 current * current * h, conduction * h, h, config.coolantTemp, next.data() + first);
+        temp.swap(next);
+        copyGhosts();
+    }
+    updateStats();
+}
+
+// No heat flows across the pack boundary
+void PackThermalModel::copyGhosts() {
+    for (int r = 1; r <= rows; r++) {
+        double* row = temp.data() + r * stride;
+        row[0] = row[1];
+        row[columns + 1] = row[columns];
+    }
+    std::copy(temp.begin() + stride, temp.begin() + 2 * stride, temp.begin());
+    std::copy(temp.begin() + rows * stride, temp.begin() + (rows + 1) * stride, temp.begin() + (rows + 1) * stride);
+}
+
+void PackThermalModel::updateStats() {
+    maxTemp = -INFINITY;
+    minTemp = INFINITY;
+    double sum = 0.0;
+    for (int r = 1; r <= rows; r++) {
+        const double* row = temp.data() + r * stride + 1;
+        for (int c = 0; c < columns; c++) {
+            maxTemp = std::max(maxTemp, row[c]);
+            minTemp = std::min(minTemp, row[c]);
+            sum += row[c];
+        }
+    }
+    meanTemp = sum / (rows * columns);
+}
@@ -0,0 +1,279 @@
+#include "ProfileCatalog.h"
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static bool parseBrand(std::string_view text, VehicleBrand& brand) {
+    if (text == "TESLA")            brand = VehicleBrand::TESLA;
+    else if (text == "HYUNDAI")     brand = VehicleBrand::HYUNDAI;
+    else if (text == "VINFAST")     brand = VehicleBrand::VINFAST;
+    else if (text == "-")           brand = VehicleBrand::NOT_SET;
+    else return false;
+    return true;
+}
+
+static bool parseOption(std::string_view text, VehicleOption& option) {
+    if (text == "STANDARD" || text == "STANDAND")   option = VehicleOption::STANDAND;
+    else if (text == "LONG_RANGE")                  option = VehicleOption::LONG_RANGE;
+    else if (text == "PERFORMANCE")                 option = VehicleOption::PERFORMANCE;
+    else if (text == "-")                           option = VehicleOption::NOT_SET;
+    else return false;
+    return true;
+}
+
+static bool parseValue(std::string_view text, designValue& value) {
+    std::string digits(text);
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(digits.c_str(), &end, 10);
+    if (digits.empty() || *end != '\0' || errno != 0 || parsed < 0 || parsed > INT16_MAX) {
+        return false;
+    }
+    value = static_cast<designValue>(parsed);
+    return true;
+}
+
+// Comma-separated fields of one line, surrounding spaces trimmed
+static void splitFields(std::string_view line, std::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        std::string_view field = line.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start);
+        while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+        while (!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r')) field.remove_suffix(1);
+        fields.push_back(field);
+        if (comma == std::string_view::npos) break;
+        start = comma + 1;
+    }
+}
+
+std::shared_ptr<const ProfileCatalog> ProfileCatalog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open profile catalog " << path << std::endl;
+        return nullptr;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+
+    std::shared_ptr<ProfileCatalog> catalog(new ProfileCatalog());
+    if (!catalog->parse(path, text.str())) {
+        return nullptr;
+    }
+    return catalog;
+}
+
+bool ProfileCatalog::parse(const std::string& path, const std::string& text) {
+    enum Column { NAME = -1, BRAND = -2, OPTION = -3 };
+    std::vector<int> columns;       // attribute index, or NAME / BRAND / OPTION
+    std::vector<std::string_view> fields;
+    std::string_view rest(text);
+    int lineNumber = 0;
+
+    while (!rest.empty()) {
+        size_t newline = rest.find('\n');
+        std::string_view line = rest.substr(0, newline);
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+        lineNumber++;
+        if (line.empty() || line.front() == '#' || line == "\r") {
+            continue;
+        }
+        splitFields(line, fields);
+
+        if (columns.empty()) {
+            uint32_t seen = 0;
+            int required = 0;
+            for (std::string_view field : fields) {
+                VehicleAttribute attribute;
+                if (field == "name")        { columns.push_back(NAME); required |= 1; }
+                else if (field == "brand")  { columns.push_back(BRAND); required |= 2; }
+                else if (field == "option") { columns.push_back(OPTION); required |= 4; }
+                else if (parseAttribute(std::string(field), attribute)) {
+                    columns.push_back(static_cast<int>(attribute));
+                    seen |= 1u << static_cast<int>(attribute);
+                } else {
+                    std::cerr << path << ":" << lineNumber << ": unknown column " << field << std::endl;
+                    return false;
+                }
+            }
+            if (required != 7 || seen != (1u << VEHICLE_ATTRIBUTE_COUNT) - 1) {
+                std::cerr << path << ":" << lineNumber << ": the header needs name, brand, option and every attribute"
+                          << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        if (fields.size() != columns.size()) {
+            std::cerr << path << ":" << lineNumber << ": expected " << columns.size() << " fields, skipped" << std::endl;
+            continue;
+        }
+        Entry entry{};
+        std::string_view name;
+        bool valid = true;
+        for (size_t c = 0; c < columns.size() && valid; c++) {
+            if (columns[c] == NAME) {
+                name = fields[c];
+                valid = !name.empty();
+            } else if (columns[c] == BRAND) {
+                valid = parseBrand(fields[c], entry.brand);
+            } else if (columns[c] == OPTION) {
+                valid = parseOption(fields[c], entry.option);
+            } else {
+                designValue value = 0;
+                valid = parseValue(fields[c], value);
+                if (valid) entry.design.set(static_cast<VehicleAttribute>(columns[c]), value);
+            }
+        }
+        if (!valid) {
+            std::cerr << path << ":" << lineNumber << ": invalid value, skipped" << std::endl;
+            continue;
+        }
+        if (find(name) >= 0) {
+            std::cerr << path << ":" << lineNumber << ": duplicate model " << name << ", skipped" << std::endl;
+            continue;
+        }
+
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(name.size());
+        names.append(name.data(), name.size());
+        uint32_t index = static_cast<uint32_t>(entries.size());
+        entries.push_back(entry);
+        auto position = std::lower_bound(byName.begin(), byName.end(), name,
+                                         [this](uint32_t i, std::string_view key) { return getName(i) < key; });
+        byName.insert(position, index);
+    }
+
+    if (columns.empty()) {
+        std::cerr << path << ": no header row" << std::endl;
+        return false;
+    }
+    entries.shrink_to_fit();
+    byName.shrink_to_fit();
+    names.shrink_to_fit();
+    return true;
+}
+
+int ProfileCatalog::find(std::string_view name) const {
+    auto position = std::lower_bound(byName.begin(), byName.end(), name,
+                                     [this](uint32_t i, std::string_view key) { return getName(i) < key; });
+    if (position == byName.end() || getName(*position) != name) {
+        return -1;
+    }
+    return static_cast<int>(*position);
+}
+
+std::string_view ProfileCatalog::getName(size_t index) const {
+    const Entry& entry = entries[index];
+    return std::string_view(names.data() + entry.nameOffset, entry.nameLength);
+}
+
+std::shared_ptr<const VehicleProfile> ProfileCatalog::createProfile(size_t index) const {
+    const Entry& entry = entries[index];
+    return VehicleProfile::create(entry.brand, entry.option, entry.design);
+}
+
+size_t ProfileCatalog::getIndexBytes() const {
+    return entries.capacity() * sizeof(Entry) + byName.capacity() * sizeof(uint32_t) + names.capacity();
+}
+
+ProfileWatcher::ProfileWatcher(const std::string& catalogPath, const std::string& profileName,
+                               std::shared_ptr<const VehicleProfile> current)
+    : path(catalogPath), name(profileName), current(std::move(current)), reloads(0), stopEventFd(-1) {
+    stopEventFd = eventfd(0, EFD_NONBLOCK);
+    if (stopEventFd == -1) {
+        std::cerr << "Failed to create eventfd, profile changes will not be detected" << std::endl;
+        return;
+    }
+    watcher = std::thread(&ProfileWatcher::watchLoop, this);
+}
+
+ProfileWatcher::~ProfileWatcher() {
+    if (stopEventFd == -1) {
+        return;
+    }
+    uint64_t one = 1;
+    if (write(stopEventFd, &one, sizeof(one)) != sizeof(one)) {
+        std::cerr << "Failed to stop profile watcher" << std::endl;
+    }
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+    close(stopEventFd);
+}
+
+std::shared_ptr<const VehicleProfile> ProfileWatcher::takeUpdate() {
+    if (!std::atomic_load(&pending)) {
+        return nullptr;
+    }
+    return std::atomic_exchange(&pending, std::shared_ptr<const VehicleProfile>());
+}
+
+void ProfileWatcher::reload() {
+    std::shared_ptr<const ProfileCatalog> catalog = ProfileCatalog::load(path);
+    if (!catalog) {
+        std::cerr << "Keeping profile " << name << std::endl;
+        return;
+    }
+    int index = catalog->find(name);
+    if (index < 0) {
+        std::cerr << "Profile " << name << " is no longer in " << path << ", keeping it" << std::endl;
+        return;
+    }
+    if (current && catalog->getDesignValues(index) == current->baseParam &&
+        catalog->getBrand(index) == current->brand && catalog->getOption(index) == current->option) {
+        return;     // rewritten without a change to this model
+    }
+    current = catalog->createProfile(index);
+    std::atomic_store(&pending, current);
+    reloads++;
+}
+
+void ProfileWatcher::watchLoop() {
+    size_t slash = path.find_last_of('/');
+    const std::string directory = (slash == std::string::npos) ? "." : path.substr(0, slash);
+    const std::string file = (slash == std::string::npos) ? path : path.substr(slash + 1);
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK);
+    if (inotifyFd == -1 || inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        std::cerr << "Failed to watch " << directory << ", profile changes will not be detected" << std::endl;
+        if (inotifyFd != -1) close(inotifyFd);
+        return;
+    }
+
+    alignas(struct inotify_event) char buffer[4096];
+    struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopEventFd, POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+
+        bool touched = false;
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                if (event->len > 0 && file == event->name) {
+                    touched = true;
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        if (touched) {
+            reload();
+        }
+    }
+    close(inotifyFd);
+}
@@ -0,0 +1,73 @@
+#include "ProfileTables.h"
+#include "VehicleConfig.h"
+#include <atomic>
+
+static std::shared_ptr<const ProfileTables> loadedTables;
+
+ProfileTables::ProfileTables(int maxRpm, int maxTorque, int wheelRadius) {
+    const int FULL_PEDAL = 100;
+    maxRpm = std::max(maxRpm, 0);
+    double wheelRadiusMeters = wheelRadius / 100.0;
+    double rpmPerSpeed = wheelRadius > 0
+        ? (VehicleCalculator::GR * 60.0) / (2.0 * VehicleCalculator::PI * wheelRadiusMeters) : 0.0;
+    knotsPerSpeed = rpmPerSpeed / RPM_STEP;
+    lastKnot = static_cast<double>(maxRpm) / RPM_STEP;
+
+    // Full-pedal values at an RPM, divided by 100 to scale by the pedal percentage
+    auto perPercent = [&](int rpm, double& torque, double& traction, double& power) {
+        double full = VehicleCalculator::getTorque(rpm, maxRpm, FULL_PEDAL, maxTorque);
+        torque = full / FULL_PEDAL;
+        traction = (wheelRadius > 0 ? VehicleCalculator::getTractiveForce(wheelRadius, full) : 0.0) / FULL_PEDAL;
+        power = VehicleCalculator::getPowerEngine(full, VehicleCalculator::getAngularSpeed(rpm)) / FULL_PEDAL;
+    };
+
+    // One extra knot so interpolation at maxRpm never reads past the end
+    size_t count = static_cast<size_t>(maxRpm / RPM_STEP) + 2;
+    knots.resize(count);
+    for (size_t k = 0; k < count; k++) {
+        int rpm = std::min(static_cast<int>(k) * RPM_STEP, maxRpm);
+        int nextRpm = std::min(rpm + RPM_STEP, maxRpm);
+        Knot& knot = knots[k];
+        double nextTorque, nextTraction, nextPower;
+        perPercent(rpm, knot.torque, knot.traction, knot.power);
+        perPercent(nextRpm, nextTorque, nextTraction, nextPower);
+
+        // Change per knot; the last segment is shorter when maxRpm is not a multiple of RPM_STEP
+        double span = nextRpm > rpm ? static_cast<double>(RPM_STEP) / (nextRpm - rpm) : 0.0;
+        knot.torqueSlope = (nextTorque - knot.torque) * span;
+        knot.tractionSlope = (nextTraction - knot.traction) * span;
+        knot.powerSlope = (nextPower - knot.power) * span;
+    }
+}
+
+void ProfileTables::load() {
+    std::atomic_store(&loadedTables, std::shared_ptr<const ProfileTables>(new ProfileTables(
+        ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RPM),
+        ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_TORQUE),
+        ElectricVehicleInit::getDesignValue(VehicleAttribute::WHEEL_RADIUS))));
+}
+
+std::shared_ptr<const ProfileTables> ProfileTables::current() {
+    std::shared_ptr<const ProfileTables> tables = std::atomic_load(&loadedTables);
+    if (!tables) {
+        load();
+        tables = std::atomic_load(&loadedTables);
+    }
+    return tables;
+}
+
+double ProfileTables::torque(int rpm, int gasLevel) const {
+    if (gasLevel <= 0) return 0.0;
+    double position = std::min(std::max(static_cast<double>(rpm) / RPM_STEP, 0.0), lastKnot);
+    int index = static_cast<int>(position);
+    const Knot& knot = knots[index];
+    return (knot.torque + knot.torqueSlope * (position - index)) * gasLevel;
+}
+
+double ProfileTables::tractiveForce(int rpm, int gasLevel) const {
+    if (gasLevel <= 0) return 0.0;
+    double position = std::min(std::max(static_cast<double>(rpm) / RPM_STEP, 0.0), lastKnot);
+    int index = static_cast<int>(position);
+    const Knot& knot = knots[index];
+    return (knot.traction + knot.tractionSlope * (position - index)) * gasLevel;
+}
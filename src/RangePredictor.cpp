@@ -0,0 +1,94 @@
+#include "RangePredictor.h"
+#include "SpeedCalculator.h"
+#include <algorithm>
+#include <cmath>
+
+RangePredictor::RangePredictor(const VehicleProfile& profile)
+    : scale(1.0), recentDistance(0.0), recentHours(0.0), recentDrive(0.0) {
+    int maxSpeed = std::max(profile.getDesignValue(VehicleAttribute::MAX_SPEED_SPORT), SPEED_BAND_KMH);
+    int weight = profile.getDesignValue(VehicleAttribute::WEIGHT) + SpeedCalculator::LOAD;
+    int maxRange = profile.getDesignValue(VehicleAttribute::MAX_RANGE);
+    ratedKwhPerKm = maxRange > 0 ? static_cast<double>(profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY)) / maxRange : 0.1;
+
+    // Road load at the centre of each band: kW at the wheels over km/h
+    bands.resize(static_cast<size_t>(maxSpeed / SPEED_BAND_KMH) + 1);
+    for (size_t b = 0; b < bands.size(); b++) {
+        double speedKmh = (b + 0.5) * SPEED_BAND_KMH;
+        double speed = speedKmh / 3.6;
+        double force = VehicleCalculator::getRollingFriction(weight) + VehicleCalculator::getAirDragForce(speed);
+        double powerKw = force * speed / VehicleCalculator::EFFICIENCY_DRIVE / 1000.0;
+        Band& band = bands[b];
+        band.seeded = powerKw / speedKmh;
+        band.energy = 0.0;
+        band.distance = 0.0;
+        band.kwhPerKm = band.seeded;
+        band.weight = 0.0;
+    }
+}
+
+size_t RangePredictor::bandOf(double speedKmh) const {
+    if (speedKmh <= 0.0) return 0;
+    return std::min(static_cast<size_t>(speedKmh / SPEED_BAND_KMH), bands.size() - 1);
+}
+
+void RangePredictor::observe(double speedKmh, double distanceKm, double energyKwH, double auxPowerW, double seconds) {
+    if (distanceKm < 0.0 || seconds < 0.0) {
+        return;
+    }
+    double hours = seconds / 3600.0;
+    double driveKwH = std::max(energyKwH - auxPowerW / 1000.0 * hours, 0.0);
+    Band& band = bands[bandOf(speedKmh)];
+
+    // Update the band, and the profile sum by the change of its value
+    double fade = std::max(1.0 - distanceKm / HISTORY_KM, 0.0);
+    band.energy = band.energy * fade + driveKwH;
+    band.distance = band.distance * fade + distanceKm;
+    double kwhPerKm = (band.seeded * PRIOR_KM + band.energy) / (PRIOR_KM + band.distance);
+    recentDrive += band.weight * (kwhPerKm - band.kwhPerKm);
+    band.kwhPerKm = kwhPerKm;
+
+    // Fade the profile by the distance driven, then add this tick
+    scale *= std::max(1.0 - distanceKm / PROFILE_KM, 0.0);
+    if (scale < 1e-100) {
+        rescale();
+    }
+    band.weight += distanceKm / scale;
+    recentDistance += distanceKm / scale;
+    recentHours += hours / scale;
+    recentDrive += distanceKm / scale * band.kwhPerKm;
+}
+
+// Fold scale into the stored values before it underflows
+void RangePredictor::rescale() {
+    if (scale <= 0.0) {
+        for (Band& band : bands) band.weight = 0.0;
+        recentDistance = recentHours = recentDrive = 0.0;
+    } else {
+        for (Band& band : bands) band.weight *= scale;
+        recentDistance *= scale;
+        recentHours *= scale;
+        recentDrive *= scale;
+    }
+    scale = 1.0;
+}
+
+double RangePredictor::consumption(double speedKmh, double auxPowerW) const {
+    double position = std::max(speedKmh / SPEED_BAND_KMH - 0.5, 0.0);
+    size_t lower = std::min(static_cast<size_t>(position), bands.size() - 1);
+    size_t upper = std::min(lower + 1, bands.size() - 1);
+    double fraction = std::min(position - lower, 1.0);
+    double drive = bands[lower].kwhPerKm + (bands[upper].kwhPerKm - bands[lower].kwhPerKm) * fraction;
+    return drive + auxPowerW / 1000.0 / std::max(speedKmh, static_cast<double>(SPEED_BAND_KMH) / 2);
+}
+
+double RangePredictor::expectedConsumption(double auxPowerW) const {
+    double distance = recentDistance * scale + PRIOR_KM;
+    double drive = (recentDrive * scale + ratedKwhPerKm * PRIOR_KM) / distance;
+    double hoursPerKm = (recentHours * scale + PRIOR_KM / PRIOR_SPEED_KMH) / distance;
+    return drive + auxPowerW / 1000.0 * hoursPerKm;
+}
+
+double RangePredictor::predictRange(double remainingKwH, double auxPowerW) const {
+    double kwhPerKm = expectedConsumption(auxPowerW);
+    return kwhPerKm > 0.0 ? std::max(remainingKwH, 0.0) / kwhPerKm : 0.0;
+}
@@ -1,12 +1,10 @@
 #include "SafetyManager.h"
 
-#define MAX_PEDAL 100
 #define MIN_PEDAL 0
 
 SafetyManager::SafetyManager() {
     brakeIntensity = 0;
     acceleratorIntensity = 0;
-    std::cout << "SafetyManager initialized" << std::endl;
 }
 
 SafetyManager::~SafetyManager() {}
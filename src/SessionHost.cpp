@@ -0,0 +1,76 @@
+#include "SessionHost.h"
+#include <algorithm>
+#include <thread>
+
+SessionHost::SessionHost(ThreadPool* pool) : pool(pool), ticks(0), sessionTicks(0), overruns(0) {}
+
+SessionHost::~SessionHost() {}
+
+DashboardSession* SessionHost::addSession(std::unique_ptr<DashboardSession> session) {
+    if (!session || !session->isOpen()) {
+        std::cerr << "Session not added, its data store is not open" << std::endl;
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    sessions.push_back(std::move(session));
+    return sessions.back().get();
+}
+
+bool SessionHost::removeSession(int id) {
+    std::unique_ptr<DashboardSession> removed;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        auto it = std::find_if(sessions.begin(), sessions.end(),
+                               [id](const std::unique_ptr<DashboardSession>& session) { return session->getId() == id; });
+        if (it == sessions.end()) {
+            return false;
+        }
+        removed = std::move(*it);
+        sessions.erase(it);
+    }
+    // The final flush of its store happens outside the lock
+    removed.reset();
+    return true;
+}
+
+DashboardSession* SessionHost::getSession(int id) {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    for (const auto& session : sessions) {
+        if (session->getId() == id) {
+            return session.get();
+        }
+    }
+    return nullptr;
+}
+
+size_t SessionHost::getSessionCount() {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    return sessions.size();
+}
+
+void SessionHost::tick() {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    pool->parallelFor(sessions.size(), GRAIN, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            sessions[i]->step();
+        }
+    });
+    ticks.fetch_add(1, std::memory_order_relaxed);
+    sessionTicks.fetch_add(sessions.size(), std::memory_order_relaxed);
+}
+
+void SessionHost::run(std::chrono::milliseconds period, const std::atomic<bool>& running) {
+    auto next = std::chrono::steady_clock::now();
+    while (running) {
+        tick();
+        next += period;
+        auto now = std::chrono::steady_clock::now();
+        if (now > next) {
+            // Behind schedule: count it and start the next period from now instead of bursting
+            overruns.fetch_add(1, std::memory_order_relaxed);
+            next = now;
+            continue;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
@@ -0,0 +1,71 @@
+#include "SignalRegistry.h"
+#include <charconv>
+#include <cmath>
+
+bool findSignal(std::string_view csvName, SignalId& id) {
+    for (const auto& info : SIGNALS) {
+        if (csvName == info.csvName) {
+            id = info.id;
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+bool parseSignal(SignalId id, std::string_view text, double& value) {
+    text = trim(text);
+    switch (signalInfo(id).type) {
+        case SignalType::INTEGER:
+        case SignalType::REAL: {
+            double parsed;
+            auto result = std::from_chars(text.data(), text.data() + text.size(), parsed);
+            if (result.ec != std::errc()) {
+                return false;
+            }
+            value = signalInfo(id).type == SignalType::INTEGER ? std::trunc(parsed) : parsed;
+            return true;
+        }
+        case SignalType::BOOL:
+            value = (text == "1") ? 1.0 : 0.0;
+            return true;
+        case SignalType::MODE:
+            if (text == "ECO")   { value = DRIVE_MODE_ECO; return true; }
+            if (text == "SPORT") { value = DRIVE_MODE_SPORT; return true; }
+            return false;
+    }
+    return false;
+}
+
+size_t formatSignal(SignalId id, double value, char* out) {
+    char* end = out;
+    switch (signalInfo(id).type) {
+        case SignalType::INTEGER:
+            end = std::to_chars(out, out + SIGNAL_TEXT_MAX, static_cast<long long>(value)).ptr;
+            break;
+        case SignalType::REAL:
+            end = std::to_chars(out, out + SIGNAL_TEXT_MAX, value).ptr;
+            break;
+        case SignalType::BOOL:
+            *end++ = value != 0.0 ? '1' : '0';
+            break;
+        case SignalType::MODE:
+            for (const char* name = driveModeName(value); *name; name++) *end++ = *name;
+            break;
+    }
+    return end - out;
+}
+
+std::string formatSignal(SignalId id, double value) {
+    char text[SIGNAL_TEXT_MAX];
+    return std::string(text, formatSignal(id, value, text));
+}
+
+const char* driveModeName(double mode) {
+    return mode == DRIVE_MODE_SPORT ? "SPORT" : "ECO";
+}
@@ -0,0 +1,35 @@
+#include "SimulationClock.h"
+
+SimulationClock::SimulationClock(Mode mode, double fixedStep, double timeScale)
+    : mode(mode), fixedStep(clampStep(fixedStep)), timeScale(timeScale > 0.0 ? timeScale : 1.0),
+      deltaTime(MIN_STEP), simulatedTime(0.0), ticks(0), hasPreviousTick(false) {}
+
+double SimulationClock::clampStep(double step) {
+    if (step < MIN_STEP) return MIN_STEP;
+    if (step > MAX_STEP) return MAX_STEP;
+    return step;
+}
+
+double SimulationClock::tick() {
+    double step = fixedStep;
+    if (mode != Mode::FIXED_STEP) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = hasPreviousTick ? std::chrono::duration<double>(now - previousTick).count() : 0.0;
+        previousTick = now;
+        hasPreviousTick = true;
+        step = clampStep(elapsed);
+        if (mode == Mode::ACCELERATED) step *= timeScale;
+    }
+
+    deltaTime = step;
+    simulatedTime += step;
+    ticks++;
+    return step;
+}
+
+void SimulationClock::advance(double step) {
+    // Measured steps were clamped when recorded; a scaled one may be longer than MAX_STEP
+    deltaTime = step >= MIN_STEP ? step : MIN_STEP;
+    simulatedTime += deltaTime;
+    ticks++;
+}
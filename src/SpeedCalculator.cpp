@@ -1,16 +1,29 @@
 #include "SpeedCalculator.h"
 
-#define LOAD 200    // suppose max load of car is 200kg
 
-SpeedCalculator::SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager) {
+SpeedCalculator::SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager, SimulationClock* clock)
+    : SpeedCalculator(driveMode, safetyManager, clock, ElectricVehicleInit::getProfile()) {}
+
+SpeedCalculator::SpeedCalculator(DriveMode* driveMode, SafetyManager* safetyManager, SimulationClock* clock,
+                                 const VehicleProfile& profile)
+    : integrator(IntegratorMethod::EULER) {
     this->driveMode = driveMode;
     this->safetyManager = safetyManager;
+    this->clock = clock;
     totalDistance = 0.0;
+    distanceInMeters = 0.0;
     currentSpeed = 0;
     powerConsumption = 0.0;
-    maxSpeedEco = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_SPEED_ECO);
-    maxSpeedSport = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_SPEED_SPORT);
-    std::cout << "SpeedCalculator initialized" << std::endl;
+    setProfile(profile);
+    lastSpeed = 0;
+    lastAcceleration = 0.0;
+}
+
+void SpeedCalculator::setProfile(const VehicleProfile& profile) {
+    maxSpeedEco = profile.getDesignValue(VehicleAttribute::MAX_SPEED_ECO);
+    maxSpeedSport = profile.getDesignValue(VehicleAttribute::MAX_SPEED_SPORT);
+    totalWeight = profile.getDesignValue(VehicleAttribute::WEIGHT) + LOAD;
+    tables = profile.tables;
 }
 
 SpeedCalculator::~SpeedCalculator() {}
@@ -32,8 +45,6 @@ void SpeedCalculator::adjustSpeed(bool isAcceleratorPressed, bool isBrakePressed
 }
 
 void SpeedCalculator::adjustSpeedForDriveMode(const std::string& driveMode) {
-    static int lastSpeed = 0;
-    static std::string lastDriveMode = "";
     DriveModeFactor driveModeFactor;
     
     // Store the current speed before adjustment
@@ -86,20 +97,10 @@ void SpeedCalculator::adjustSpeedForDriveMode(const std::string& driveMode) {
 }
 
 int SpeedCalculator::calculateSpeed(bool isAcceleratorPressed, bool isBrakePressed) {
-    static const int MAX_RPM = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RPM);
-    static const int MAX_TORQUE = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_TORQUE);
-    static const int WHEEL_RADIUS = ElectricVehicleInit::getDesignValue(VehicleAttribute::WHEEL_RADIUS);
-    static const int VEHICLE_WEIGHT = ElectricVehicleInit::getDesignValue(VehicleAttribute::WEIGHT);
-    static const int TOTAL_WEIGHT = VEHICLE_WEIGHT + LOAD;
-    static std::string previousMode = "";
-
-    static auto previousTime = std::chrono::high_resolution_clock::now();
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    double deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - previousTime).count() / 1000.0; // Convert ms to seconds
-    
-    // Ensure we have a reasonable deltaTime 
-    if (deltaTime <= 0.001) deltaTime = 0.001;
-    if (deltaTime > 1.0) deltaTime = 1.0;
+    if (integrator.getMethod() != IntegratorMethod::EULER) {
+        return integrateSpeed(isAcceleratorPressed, isBrakePressed);
+    }
+    double deltaTime = clock->getDeltaTime();
 
     // Update safety manager based on pedal states
     adjustSpeed(isAcceleratorPressed, isBrakePressed);
@@ -109,14 +110,11 @@ int SpeedCalculator::calculateSpeed(bool isAcceleratorPressed, bool isBrakePress
     int brakeIntensity = safetyManager->getBrakeIntensity();
     double speedMetersPerSecond = currentSpeed / 3.6; // Convert km/h to m/s
     
-    int rpm = VehicleCalculator::getRpm(speedMetersPerSecond, WHEEL_RADIUS, MAX_RPM);
-    double torque = VehicleCalculator::getTorque(rpm, MAX_RPM, acceleratorIntensity, MAX_TORQUE);
-    double angularSpeed = VehicleCalculator::getAngularSpeed(rpm);
-    
-    powerConsumption = VehicleCalculator::getPowerEngine(torque, angularSpeed);
-
-    double traction = VehicleCalculator::getTractiveForce(WHEEL_RADIUS, torque);
-    double acceleration = VehicleCalculator::getAcceleration(speedMetersPerSecond, traction, TOTAL_WEIGHT, brakeIntensity);
+    // Torque curve, power and traction come from the profile's precomputed tables
+    double traction;
+    tables->atSpeed(speedMetersPerSecond, acceleratorIntensity, traction, powerConsumption);
+    double acceleration = VehicleCalculator::getAcceleration(speedMetersPerSecond, traction, totalWeight, brakeIntensity,
+                                                             lastAcceleration);
     
     speedMetersPerSecond += acceleration * deltaTime;
     
@@ -156,16 +154,59 @@ int SpeedCalculator::calculateSpeed(bool isAcceleratorPressed, bool isBrakePress
 
     double distanceThisFrame = speedMetersPerSecond * deltaTime + 0.5 * acceleration * deltaTime * deltaTime;
     
-    static double distanceInMeters = 0;
     distanceInMeters += distanceThisFrame;
     
     totalDistance = distanceInMeters / 1000.0;
 
-    previousTime = currentTime;
     previousMode = mode;
+    motion.speed = currentSpeed / 3.6;
+    motion.position = distanceInMeters;
     return currentSpeed;
 }
 
+// Speed and position stay continuous; only the returned km/h is truncated
+int SpeedCalculator::integrateSpeed(bool isAcceleratorPressed, bool isBrakePressed) {
+    double deltaTime = clock->getDeltaTime();
+    adjustSpeed(isAcceleratorPressed, isBrakePressed);
+
+    std::string mode = driveMode->getMode() == DriveMode::Mode::ECO ? "ECO" : "SPORT";
+    DriveModeFactor driveModeFactor;
+    LongitudinalModel model;
+    model.tables = tables.get();
+    model.weight = totalWeight;
+    model.gasLevel = safetyManager->getAcceleratorIntensity();
+    model.brakeLevel = safetyManager->getBrakeIntensity();
+    model.accelerating = isAcceleratorPressed;
+    model.modeFactor = mode == "ECO" ? driveModeFactor.ECO : driveModeFactor.SPORT;
+    model.maxSpeed = getMaxSpeed(mode) / 3.6;
+
+    // Same drive mode limit as the Euler path, and power at the start of the tick
+    motion.speed = std::min(motion.speed, model.maxSpeed);
+    double traction;
+    tables->atSpeed(motion.speed, model.gasLevel, traction, powerConsumption);
+
+    integrator.advance(motion, deltaTime, model);
+    motion.speed = std::min(motion.speed, model.maxSpeed);
+
+    currentSpeed = static_cast<int>(motion.speed * 3.6);
+    lastSpeed = currentSpeed;
+    lastDriveMode = mode;
+    previousMode = mode;
+    distanceInMeters = motion.position;
+    totalDistance = distanceInMeters / 1000.0;
+    return currentSpeed;
+}
+
+void SpeedCalculator::setIntegrator(IntegratorMethod method, double tolerance) {
+    integrator = Integrator(method, tolerance);
+}
+
+void SpeedCalculator::restoreDistance(double distanceKm) {
+    distanceInMeters = distanceKm * 1000.0;
+    totalDistance = distanceKm;
+    motion.position = distanceInMeters;
+}
+
 int SpeedCalculator::getMaxSpeed(const std::string& driveMode) const {
     if (driveMode == "ECO") return maxSpeedEco;
     else return maxSpeedSport;
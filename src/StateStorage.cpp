@@ -0,0 +1,84 @@
+#include "StateStorage.h"
+#include <iostream>
+
+bool StateStorage::loadFrame(SignalFrame& frame, CSVMap& extras) {
+    SignalId id;
+    double value;
+    for (const auto& [k, v] : load()) {
+        if (!findSignal(k, id)) {
+            extras[k] = v;
+        } else if (parseSignal(id, v, value)) {
+            frame.set(id, value);
+        } else {
+            std::cerr << "Invalid value for " << k << ": " << v << std::endl;
+        }
+    }
+    return true;
+}
+
+bool StateStorage::persistFrame(const SignalFrame& frame, const CSVMap& extras) {
+    CSVMap data = extras;
+    for (const auto& info : SIGNALS) {
+        if (frame.has(info.id)) {
+            data[info.csvName] = formatSignal(info.id, frame.get(info.id));
+        }
+    }
+    return persist(data);
+}
+
+CsvStorage::CsvStorage(const std::string& filename) : filename(filename) {}
+
+CSVMap CsvStorage::load() {
+    if (!readFile(filename, readBuffer)) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return {};
+    }
+
+    CSVMap data;
+    parseCsv(readBuffer, [&data](std::string_view key, std::string_view value) {
+        data[std::string(key)] = std::string(value);
+    });
+    return data;
+}
+
+// Signals are parsed straight from the read buffer, only unknown keys are copied
+bool CsvStorage::loadFrame(SignalFrame& frame, CSVMap& extras) {
+    if (!readFile(filename, readBuffer)) {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    SignalId id;
+    double value;
+    parseCsv(readBuffer, [&](std::string_view key, std::string_view text) {
+        if (!findSignal(key, id)) {
+            extras[std::string(key)] = std::string(text);
+        } else if (parseSignal(id, text, value)) {
+            frame.set(id, value);
+        } else {
+            std::cerr << "Invalid value for " << key << ": " << text << std::endl;
+        }
+    });
+    return true;
+}
+
+bool CsvStorage::persist(const CSVMap& data) {
+    writer.begin();
+    for (const auto& [k, v] : data) {
+        writer.appendRow(k, v);
+    }
+    return writer.writeFile(filename);
+}
+
+bool CsvStorage::persistFrame(const SignalFrame& frame, const CSVMap& extras) {
+    writer.begin();
+    for (const auto& info : SIGNALS) {
+        if (frame.has(info.id)) {
+            writer.appendSignal(info.id, frame.get(info.id));
+        }
+    }
+    for (const auto& [k, v] : extras) {
+        writer.appendRow(k, v);
+    }
+    return writer.writeFile(filename);
+}
@@ -0,0 +1,549 @@
+#include "TelemetryRecorder.h"
+#include "Crc32.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define FILE_HEADER_SIZE 24     // magic + version + column count + start micros
+#define BLOCK_HEADER_SIZE 12    // sample count + payload bytes + crc32
+
+uint32_t packInputFlags(const DriverInputs& inputs) {
+    uint32_t flags = 0;
+    if (inputs.isAccelerator) flags |= TELEMETRY_ACCELERATOR;
+    if (inputs.isBrake) flags |= TELEMETRY_BRAKE;
+    if (inputs.driveMode == DriveMode::Mode::SPORT) flags |= TELEMETRY_SPORT;
+    if (inputs.acStatus) flags |= TELEMETRY_AC_ON;
+    if (inputs.turnSignal == 1) flags |= TELEMETRY_TURN_LEFT;
+    if (inputs.turnSignal == 2) flags |= TELEMETRY_TURN_RIGHT;
+    return flags;
+}
+
+DriverInputs unpackInputFlags(uint32_t flags, int acTemp, int windLevel) {
+    DriverInputs inputs;
+    inputs.isAccelerator = flags & TELEMETRY_ACCELERATOR;
+    inputs.isBrake = flags & TELEMETRY_BRAKE;
+    inputs.driveMode = (flags & TELEMETRY_SPORT) ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    inputs.acStatus = flags & TELEMETRY_AC_ON;
+    inputs.turnSignal = (flags & TELEMETRY_TURN_LEFT) ? 1 : (flags & TELEMETRY_TURN_RIGHT) ? 2 : 0;
+    inputs.acTemp = acTemp;
+    inputs.windLevel = windLevel;
+    return inputs;
+}
+
+// ---- Column access ----
+
+static int64_t getIntField(const TelemetrySample& sample, size_t column) {
+    switch (static_cast<TelemetryColumn>(column)) {
+        case TelemetryColumn::TIMESTAMP: return sample.timestampMicros;
+        case TelemetryColumn::SPEED:     return sample.speed;
+        case TelemetryColumn::GAS:       return sample.gasIntensity;
+        case TelemetryColumn::BRAKE:     return sample.brakeIntensity;
+        case TelemetryColumn::INPUTS:    return sample.inputFlags;
+        case TelemetryColumn::AC_TEMP:   return sample.acTemp;
+        case TelemetryColumn::WIND:      return sample.windLevel;
+        default:                         return 0;
+    }
+}
+
+static void setIntField(TelemetrySample& sample, size_t column, int64_t value) {
+    switch (static_cast<TelemetryColumn>(column)) {
+        case TelemetryColumn::TIMESTAMP: sample.timestampMicros = value; break;
+        case TelemetryColumn::SPEED:     sample.speed = static_cast<int>(value); break;
+        case TelemetryColumn::GAS:       sample.gasIntensity = static_cast<int>(value); break;
+        case TelemetryColumn::BRAKE:     sample.brakeIntensity = static_cast<int>(value); break;
+        case TelemetryColumn::INPUTS:    sample.inputFlags = static_cast<uint32_t>(value); break;
+        case TelemetryColumn::AC_TEMP:   sample.acTemp = static_cast<int>(value); break;
+        case TelemetryColumn::WIND:      sample.windLevel = static_cast<int>(value); break;
+        default: break;
+    }
+}
+
+static double& realField(TelemetrySample& sample, size_t column) {
+    switch (static_cast<TelemetryColumn>(column)) {
+        case TelemetryColumn::POWER:        return sample.powerConsumption;
+        case TelemetryColumn::KWH:          return sample.currentKwH;
+        case TelemetryColumn::BATTERY_TEMP: return sample.batteryTemp;
+        default:                            return sample.odometer;
+    }
+}
+
+static TelemetryEncoding columnEncoding(size_t column) {
+    if (column == static_cast<size_t>(TelemetryColumn::TIMESTAMP)) return TelemetryEncoding::DELTA_OF_DELTA;
+    return column < TELEMETRY_INT_COLUMNS ? TelemetryEncoding::DELTA : TelemetryEncoding::XOR;
+}
+
+// ---- Byte and bit encoding ----
+
+static void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+static void patchU32(std::vector<uint8_t>& out, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+static uint32_t getU32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// MSB-first bit stream appended to a byte vector
+class BitWriter {
+public:
+    BitWriter(std::vector<uint8_t>& out) : out(out), accumulator(0), pending(0) {}
+
+    void write(uint64_t value, int count) {
+        if (count > 32) {
+            write(value >> 32, count - 32);
+            write(value & 0xFFFFFFFFu, 32);
+            return;
+        }
+        accumulator = (accumulator << count) | (value & ((1ULL << count) - 1));
+        pending += count;
+        while (pending >= 8) {
+            out.push_back(static_cast<uint8_t>(accumulator >> (pending - 8)));
+            pending -= 8;
+        }
+        accumulator &= (1ULL << pending) - 1;
+    }
+
+    void finish() {
+        if (pending > 0) {
+            out.push_back(static_cast<uint8_t>(accumulator << (8 - pending)));
+        }
+        accumulator = 0;
+        pending = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t accumulator;
+    int pending;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data(data), bitCount(size * 8), position(0), overrun(false) {}
+
+    uint64_t read(int count) {
+        uint64_t value = 0;
+        while (count > 0) {
+            if (position >= bitCount) {
+                overrun = true;
+                return 0;
+            }
+            int offset = position & 7;
+            int available = 8 - offset;
+            int take = available < count ? available : count;
+            uint64_t chunk = (data[position >> 3] >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | chunk;
+            position += take;
+            count -= take;
+        }
+        return value;
+    }
+
+    bool failed() const { return overrun; }
+
+private:
+    const uint8_t* data;
+    size_t bitCount;
+    size_t position;
+    bool overrun;
+};
+
+static void encodeInts(const std::vector<int64_t>& values, TelemetryEncoding encoding, std::vector<uint8_t>& out) {
+    uint64_t previous = 0, previousDelta = 0;
+    for (int64_t value : values) {
+        uint64_t delta = static_cast<uint64_t>(value) - previous;
+        if (encoding == TelemetryEncoding::DELTA_OF_DELTA) {
+            putVarint(out, zigzag(static_cast<int64_t>(delta - previousDelta)));
+            previousDelta = delta;
+        } else {
+            putVarint(out, zigzag(static_cast<int64_t>(delta)));
+        }
+        previous = static_cast<uint64_t>(value);
+    }
+}
+
+static bool decodeInts(const uint8_t* data, size_t size, TelemetryEncoding encoding, std::vector<int64_t>& values) {
+    const uint8_t* end = data + size;
+    uint64_t previous = 0, previousDelta = 0;
+    for (auto& value : values) {
+        uint64_t encoded;
+        if (!getVarint(data, end, encoded)) return false;
+        uint64_t delta = static_cast<uint64_t>(unzigzag(encoded));
+        if (encoding == TelemetryEncoding::DELTA_OF_DELTA) {
+            delta += previousDelta;
+            previousDelta = delta;
+        }
+        previous += delta;
+        value = static_cast<int64_t>(previous);
+    }
+    return true;
+}
+
+// Gorilla: identical values cost 1 bit, others reuse the previous window of meaningful bits when they fit
+static void encodeReals(const std::vector<double>& values, std::vector<uint8_t>& out) {
+    BitWriter bits(out);
+    uint64_t previous = 0;
+    int previousLeading = -1, previousTrailing = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        uint64_t current;
+        std::memcpy(&current, &values[i], sizeof(current));
+        if (i == 0) {
+            bits.write(current, 64);
+            previous = current;
+            continue;
+        }
+        uint64_t x = current ^ previous;
+        previous = current;
+        if (x == 0) {
+            bits.write(0, 1);
+            continue;
+        }
+        int leading = __builtin_clzll(x);
+        int trailing = __builtin_ctzll(x);
+        if (leading > 31) leading = 31;
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            bits.write(0b10, 2);
+            bits.write(x >> previousTrailing, 64 - previousLeading - previousTrailing);
+        } else {
+            int significant = 64 - leading - trailing;
+            bits.write(0b11, 2);
+            bits.write(leading, 5);
+            bits.write(significant & 63, 6);    // 64 is stored as 0
+            bits.write(x >> trailing, significant);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+    bits.finish();
+}
+
+static bool decodeReals(const uint8_t* data, size_t size, std::vector<double>& values) {
+    BitReader bits(data, size);
+    uint64_t previous = 0;
+    int leading = 0, trailing = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i == 0) {
+            previous = bits.read(64);
+        } else if (bits.read(1)) {
+            if (bits.read(1)) {
+                leading = static_cast<int>(bits.read(5));
+                int significant = static_cast<int>(bits.read(6));
+                if (significant == 0) significant = 64;
+                trailing = 64 - leading - significant;
+                if (trailing < 0) return false;
+            }
+            previous ^= bits.read(64 - leading - trailing) << trailing;
+        }
+        std::memcpy(&values[i], &previous, sizeof(previous));
+    }
+    return !bits.failed();
+}
+
+// ---- Recorder ----
+
+static int64_t wallClockMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static bool writeFully(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t count = write(fd, data, size);
+        if (count <= 0) return false;
+        data += count;
+        size -= count;
+    }
+    return true;
+}
+
+TelemetryRecorder::TelemetryRecorder(const std::string& path)
+    : path(path), fd(-1), writerIdle(false), stopWriter(false), samplesRecorded(0), samplesDropped(0) {
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd == -1) {
+        std::cerr << "Failed to open telemetry log: " << path << std::endl;
+        return;
+    }
+
+    std::vector<uint8_t> header(TELEMETRY_MAGIC, TELEMETRY_MAGIC + sizeof(TELEMETRY_MAGIC));
+    putU32(header, TELEMETRY_VERSION);
+    putU32(header, TELEMETRY_COLUMNS);
+    uint64_t startMicros = static_cast<uint64_t>(wallClockMicros());
+    putU32(header, static_cast<uint32_t>(startMicros));
+    putU32(header, static_cast<uint32_t>(startMicros >> 32));
+    if (!writeFully(fd, header.data(), header.size())) {
+        std::cerr << "Failed to write telemetry log: " << path << std::endl;
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+
+    writerStats.encodedBytes = header.size();
+    block.reserve(BLOCK_SAMPLES);
+    intColumn.reserve(BLOCK_SAMPLES);
+    realColumn.reserve(BLOCK_SAMPLES);
+    encoded.reserve(BLOCK_SAMPLES * TELEMETRY_RAW_SAMPLE_BYTES);
+    writer = std::thread(&TelemetryRecorder::writerLoop, this);
+}
+
+TelemetryRecorder::~TelemetryRecorder() {
+    close();
+}
+
+bool TelemetryRecorder::record(const TelemetrySample& sample) {
+    if (fd == -1 || !queue.tryPush(sample)) {
+        samplesDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    samplesRecorded.fetch_add(1, std::memory_order_relaxed);
+
+    // A full block is waiting: wake the writer if it is parked
+    if (queue.size() >= BLOCK_SAMPLES) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerIdle.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writerCv.notify_one();
+        }
+    }
+    return true;
+}
+
+void TelemetryRecorder::close() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (stopWriter) {
+            return;
+        }
+        stopWriter = true;
+    }
+    writerCv.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    if (fd != -1) {
+        fdatasync(fd);
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+TelemetryStats TelemetryRecorder::getStats() {
+    TelemetryStats stats;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats = writerStats;
+    }
+    stats.samplesRecorded = samplesRecorded.load(std::memory_order_relaxed);
+    stats.samplesDropped = samplesDropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TelemetryRecorder::writerLoop() {
+    auto blockOpened = std::chrono::steady_clock::now();
+    const auto interval = std::chrono::milliseconds(FLUSH_INTERVAL_MS);
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        writerCv.wait_for(lock, interval, [this] { return stopWriter || queue.size() >= BLOCK_SAMPLES; });
+        writerIdle.store(false, std::memory_order_relaxed);
+        bool stop = stopWriter;
+        lock.unlock();
+
+        TelemetrySample sample;
+        while (queue.tryPop(sample)) {
+            if (block.empty()) {
+                blockOpened = std::chrono::steady_clock::now();
+            }
+            block.push_back(sample);
+            if (block.size() == BLOCK_SAMPLES) {
+                writeBlock();
+            }
+        }
+        // Bound how much of the trip a crash can lose
+        if (!block.empty() && (stop || std::chrono::steady_clock::now() - blockOpened >= interval)) {
+            writeBlock();
+        }
+
+        lock.lock();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+bool TelemetryRecorder::writeBlock() {
+    auto start = std::chrono::steady_clock::now();
+    encoded.clear();
+    putU32(encoded, static_cast<uint32_t>(block.size()));
+    putU32(encoded, 0);     // payload bytes, patched below
+    putU32(encoded, 0);     // crc32, patched below
+
+    for (size_t column = 0; column < TELEMETRY_COLUMNS; column++) {
+        TelemetryEncoding encoding = columnEncoding(column);
+        encoded.push_back(static_cast<uint8_t>(encoding));
+        size_t lengthOffset = encoded.size();
+        putU32(encoded, 0);
+        size_t columnStart = encoded.size();
+        if (column < TELEMETRY_INT_COLUMNS) {
+            intColumn.clear();
+            for (const auto& sample : block) intColumn.push_back(getIntField(sample, column));
+            encodeInts(intColumn, encoding, encoded);
+        } else {
+            realColumn.clear();
+            for (auto& sample : block) realColumn.push_back(realField(sample, column));
+            encodeReals(realColumn, encoded);
+        }
+        patchU32(encoded, lengthOffset, static_cast<uint32_t>(encoded.size() - columnStart));
+    }
+    size_t payloadBytes = encoded.size() - BLOCK_HEADER_SIZE;
+    patchU32(encoded, 4, static_cast<uint32_t>(payloadBytes));
+    patchU32(encoded, 8, crc32(encoded.data() + BLOCK_HEADER_SIZE, payloadBytes));
+    auto encodedAt = std::chrono::steady_clock::now();
+
+    bool written = writeFully(fd, encoded.data(), encoded.size());
+    auto end = std::chrono::steady_clock::now();
+    if (!written) {
+        std::cerr << "Failed to write telemetry log: " << path << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    writerStats.encodeMs += std::chrono::duration<double, std::milli>(encodedAt - start).count();
+    writerStats.writeMs += std::chrono::duration<double, std::milli>(end - encodedAt).count();
+    if (written) {
+        writerStats.samplesWritten += block.size();
+        writerStats.blocksWritten++;
+        writerStats.rawBytes += block.size() * TELEMETRY_RAW_SAMPLE_BYTES;
+        writerStats.encodedBytes += encoded.size();
+    }
+    block.clear();
+    return written;
+}
+
+// ---- Reader ----
+
+static size_t readFully(int fd, uint8_t* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t count = read(fd, data + total, size - total);
+        if (count <= 0) break;
+        total += count;
+    }
+    return total;
+}
+
+TelemetryReader::TelemetryReader(const std::string& path) : fd(-1), startMicros(0), truncated(false) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Failed to open telemetry log: " << path << std::endl;
+        return;
+    }
+    uint8_t header[FILE_HEADER_SIZE];
+    if (readFully(fd, header, sizeof(header)) != sizeof(header) ||
+        std::memcmp(header, TELEMETRY_MAGIC, sizeof(TELEMETRY_MAGIC)) != 0 ||
+        getU32(header + 8) != TELEMETRY_VERSION || getU32(header + 12) != TELEMETRY_COLUMNS) {
+        std::cerr << "Not a telemetry log: " << path << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+    startMicros = static_cast<int64_t>(getU32(header + 16) | (static_cast<uint64_t>(getU32(header + 20)) << 32));
+}
+
+TelemetryReader::~TelemetryReader() {
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+bool TelemetryReader::nextBlock(std::vector<TelemetrySample>& samples) {
+    samples.clear();
+    if (fd == -1 || truncated) {
+        return false;
+    }
+    uint8_t header[BLOCK_HEADER_SIZE];
+    size_t headerBytes = readFully(fd, header, sizeof(header));
+    if (headerBytes == 0) {
+        return false;
+    }
+    uint32_t count = getU32(header);
+    uint32_t payloadBytes = getU32(header + 4);
+    payload.resize(payloadBytes);
+    if (headerBytes != sizeof(header) || readFully(fd, payload.data(), payloadBytes) != payloadBytes ||
+        crc32(payload.data(), payloadBytes) != getU32(header + 8)) {
+        truncated = true;
+        return false;
+    }
+
+    samples.resize(count);
+    intColumn.resize(count);
+    realColumn.resize(count);
+    const uint8_t* data = payload.data();
+    const uint8_t* end = data + payloadBytes;
+    for (size_t column = 0; column < TELEMETRY_COLUMNS; column++) {
+        if (end - data < 5) {
+            truncated = true;
+            return false;
+        }
+        auto encoding = static_cast<TelemetryEncoding>(data[0]);
+        uint32_t length = getU32(data + 1);
+        data += 5;
+        if (length > static_cast<size_t>(end - data)) {
+            truncated = true;
+            return false;
+        }
+        bool decoded;
+        if (encoding == TelemetryEncoding::XOR) {
+            decoded = decodeReals(data, length, realColumn);
+            for (size_t i = 0; decoded && i < count; i++) realField(samples[i], column) = realColumn[i];
+        } else {
+            decoded = decodeInts(data, length, encoding, intColumn);
+            for (size_t i = 0; decoded && i < count; i++) setIntField(samples[i], column, intColumn[i]);
+        }
+        if (!decoded) {
+            truncated = true;
+            return false;
+        }
+        data += length;
+    }
+    return true;
+}
+
+bool TelemetryReader::readAll(std::vector<TelemetrySample>& samples) {
+    samples.clear();
+    std::vector<TelemetrySample> block;
+    while (nextBlock(block)) {
+        samples.insert(samples.end(), block.begin(), block.end());
+    }
+    return fd != -1;
+}
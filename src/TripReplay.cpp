@@ -0,0 +1,79 @@
+#include "TripReplay.h"
+#include "BatteryManager.h"
+#include "VehicleConfig.h"
+#include "VehicleSimulation.h"
+#include <chrono>
+#include <cstring>
+
+static constexpr uint64_t FNV_OFFSET = 1469598103934665603ULL;
+static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+static void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+}
+
+static void hashValue(uint64_t& hash, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hashBytes(hash, &bits, sizeof(bits));
+}
+
+static void hashValue(uint64_t& hash, int value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+TripReplay::TripReplay(const std::vector<TelemetrySample>& samples, IntegratorMethod integrator)
+    : samples(samples), integrator(integrator) {}
+
+ReplayResult TripReplay::run() const {
+    ReplayResult result;
+    result.outputHash = FNV_OFFSET;
+    if (samples.empty()) {
+        return result;
+    }
+
+    SimulationClock clock(SimulationClock::Mode::FIXED_STEP);
+    DriveMode driveMode;
+    SafetyManager safetyManager;
+    SpeedCalculator speedCalculator(&driveMode, &safetyManager, &clock);
+    BatteryManager batteryManager(&speedCalculator, &clock);
+    speedCalculator.setIntegrator(integrator);
+
+    // Start from the charge and odometer of the first recorded tick
+    const TelemetrySample& first = samples.front();
+    double capacity = ElectricVehicleInit::getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    if (capacity > 0.0) batteryManager.restoreBatteryLevel(first.currentKwH / capacity * 100.0);
+    speedCalculator.restoreDistance(first.odometer);
+
+    VehicleSimulation simulation(&driveMode, &safetyManager, &speedCalculator, &batteryManager,
+                                 unpackInputFlags(first.inputFlags, first.acTemp, first.windLevel));
+
+    auto start = std::chrono::steady_clock::now();
+    int64_t previousMicros = first.timestampMicros;
+    for (const TelemetrySample& sample : samples) {
+        clock.advance((sample.timestampMicros - previousMicros) / 1e6);
+        previousMicros = sample.timestampMicros;
+
+        const VehicleState& state = simulation.step(unpackInputFlags(sample.inputFlags, sample.acTemp, sample.windLevel));
+
+        hashValue(result.outputHash, state.speed);
+        hashValue(result.outputHash, state.gasIntensity);
+        hashValue(result.outputHash, state.brakeIntensity);
+        hashValue(result.outputHash, state.batteryLevel);
+        hashValue(result.outputHash, state.remainingRange);
+        hashValue(result.outputHash, state.batteryTemp);
+        hashValue(result.outputHash, state.odometer);
+        hashValue(result.outputHash, batteryManager.getBatteryKwH());
+    }
+    result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.ticks = clock.getTicks();
+    result.simulatedSeconds = clock.getTime();
+    result.finalState = simulation.getState();
+    result.finalKwH = batteryManager.getBatteryKwH();
+    return result;
+}
@@ -1,10 +1,13 @@
 #include "VehicleConfig.h"
+#include "ProfileTables.h"
 
 VehicleOption ElectricVehicleInit::option = VehicleOption::NOT_SET;
 VehicleBrand ElectricVehicleInit::brand = VehicleBrand::NOT_SET;
-vehicleBaseParam ElectricVehicleInit::baseParam = {
+// Every attribute zero until a model is loaded
+static constexpr vehicleBaseParam NOT_LOADED = {
     {VehicleAttribute::BATTERY_CAPACITY,0},
     {VehicleAttribute::BATTERY_VOLTAGE,0},
+    {VehicleAttribute::MAX_RANGE,0},
     {VehicleAttribute::MAX_TORQUE,0},
     {VehicleAttribute::MAX_AC_POWER,0},
     {VehicleAttribute::MAX_ENGINE_POWER,0},
@@ -12,94 +15,26 @@ vehicleBaseParam ElectricVehicleInit::baseParam = {
     {VehicleAttribute::MAX_SPEED_ECO,0},
     {VehicleAttribute::MAX_RPM,0},
     {VehicleAttribute::WEIGHT,0},
+    {VehicleAttribute::WHEEL_RADIUS,0},
     {VehicleAttribute::AC_TEMP_MAX,0},
     {VehicleAttribute::AC_TEMP_MIN,0},
     {VehicleAttribute::WIND_LEVEL_MAX,0},
-    {VehicleAttribute::ENGINE_TOTAL,0}         
+    {VehicleAttribute::ENGINE_TOTAL,0}
 };
+static_assert(NOT_LOADED.isComplete(), "The default design values are missing an attribute");
 
-vehicleBaseParam TeslaModel3Standard = {
-    {VehicleAttribute::BATTERY_CAPACITY,54},
-    {VehicleAttribute::BATTERY_VOLTAGE,350},
-    {VehicleAttribute::MAX_RANGE,409},
-    {VehicleAttribute::MAX_TORQUE,300},
-    {VehicleAttribute::MAX_AC_POWER,2500},
-    {VehicleAttribute::MAX_ENGINE_POWER,211},
-    {VehicleAttribute::MAX_SPEED_SPORT,225},
-    {VehicleAttribute::MAX_SPEED_ECO,160},
-    {VehicleAttribute::MAX_RPM,16000},
-    {VehicleAttribute::WEIGHT,1612},
-    {VehicleAttribute::WHEEL_RADIUS,34},
-    {VehicleAttribute::AC_TEMP_MAX,28},
-    {VehicleAttribute::AC_TEMP_MIN,15},
-    {VehicleAttribute::WIND_LEVEL_MAX,5},
-    {VehicleAttribute::ENGINE_TOTAL,1}
-};
-
-vehicleBaseParam TeslaModel3LongRange = {
-    {VehicleAttribute::BATTERY_CAPACITY,75},
-    {VehicleAttribute::BATTERY_VOLTAGE,350},
-    {VehicleAttribute::MAX_RANGE,560},
-    {VehicleAttribute::MAX_TORQUE,440},
-    {VehicleAttribute::MAX_AC_POWER,3000},
-    {VehicleAttribute::MAX_ENGINE_POWER,324},
-    {VehicleAttribute::MAX_SPEED_SPORT,233},
-    {VehicleAttribute::MAX_SPEED_ECO,190},
-    {VehicleAttribute::MAX_RPM,17000},
-    {VehicleAttribute::WEIGHT,1847},
-    {VehicleAttribute::WHEEL_RADIUS,35},
-    {VehicleAttribute::AC_TEMP_MAX,28},
-    {VehicleAttribute::AC_TEMP_MIN,15},
-    {VehicleAttribute::WIND_LEVEL_MAX,5},
-    {VehicleAttribute::ENGINE_TOTAL,2},
-};
-
-vehicleBaseParam HyundaiIoniq5Performance = {
-    {VehicleAttribute::BATTERY_CAPACITY,75},
-    {VehicleAttribute::BATTERY_VOLTAGE,350},
-    {VehicleAttribute::MAX_RANGE,530},
-    {VehicleAttribute::MAX_TORQUE,650},
-    {VehicleAttribute::MAX_AC_POWER,3500},
-    {VehicleAttribute::MAX_ENGINE_POWER,393},
-    {VehicleAttribute::MAX_SPEED_SPORT,261},
-    {VehicleAttribute::MAX_SPEED_ECO,210},
-    {VehicleAttribute::MAX_RPM,18000},
-    {VehicleAttribute::WEIGHT,1847},
-    {VehicleAttribute::WHEEL_RADIUS,36},
-    {VehicleAttribute::AC_TEMP_MAX,28},
-    {VehicleAttribute::AC_TEMP_MIN,15},
-    {VehicleAttribute::WIND_LEVEL_MAX,5},
-    {VehicleAttribute::ENGINE_TOTAL,2}    
-};
-
-vehicleBaseParam HyundaiIoniq5 = {
-    {VehicleAttribute::BATTERY_CAPACITY,58},
-    {VehicleAttribute::BATTERY_VOLTAGE,360},
-    {VehicleAttribute::MAX_RANGE,400},
-    {VehicleAttribute::MAX_TORQUE,300},
-    {VehicleAttribute::MAX_AC_POWER,2500},
-    {VehicleAttribute::MAX_ENGINE_POWER,211},
-    {VehicleAttribute::MAX_SPEED_SPORT,225},
-    {VehicleAttribute::MAX_SPEED_ECO,160},
-    {VehicleAttribute::MAX_RPM,16000},
-    {VehicleAttribute::WEIGHT,1612},
-    {VehicleAttribute::WHEEL_RADIUS,34},
-    {VehicleAttribute::AC_TEMP_MAX,28},
-    {VehicleAttribute::AC_TEMP_MIN,15},
-    {VehicleAttribute::WIND_LEVEL_MAX,5},
-    {VehicleAttribute::ENGINE_TOTAL,1}
-};
+vehicleBaseParam ElectricVehicleInit::baseParam = NOT_LOADED;
 
 ElectricVehicleInit::ElectricVehicleInit(VehicleOption option, VehicleBrand brand) {
     if (brand == VehicleBrand::TESLA) {
         std::string optionName;
         this->brand = VehicleBrand::TESLA;
         if (option == VehicleOption::STANDAND) {
-            baseParam = TeslaModel3Standard;
+            baseParam = TESLA_MODEL3_STANDARD;
             this->option = VehicleOption::STANDAND;
             optionName = "STANDAND";
         } else if (option == VehicleOption::LONG_RANGE) {
-            baseParam = TeslaModel3LongRange;
+            baseParam = TESLA_MODEL3_LONG_RANGE;
             this->option = VehicleOption::LONG_RANGE;
             optionName = "LONG_RANGE";
         }
@@ -108,15 +43,16 @@ ElectricVehicleInit::ElectricVehicleInit(VehicleOption option, VehicleBrand bran
             return;
         }
         std::cout << "parameters of Tesla model 3: (" + optionName + ") is loaded" << std::endl;
+        ProfileTables::load();
     } else if (brand == VehicleBrand::HYUNDAI) {
         std::string optionName;
         this->brand = VehicleBrand::HYUNDAI;
         if (option == VehicleOption::STANDAND) {
-            baseParam = HyundaiIoniq5;
+            baseParam = HYUNDAI_IONIQ5;
             this->option = VehicleOption::STANDAND;
             optionName = "STANDAND";
         } else if (option == VehicleOption::PERFORMANCE) {
-            baseParam = HyundaiIoniq5Performance;
+            baseParam = HYUNDAI_IONIQ5_PERFORMANCE;
             this->option = VehicleOption::PERFORMANCE;
             optionName = "PERFORMANCE";
         }
@@ -125,6 +61,7 @@ ElectricVehicleInit::ElectricVehicleInit(VehicleOption option, VehicleBrand bran
             return;
         }
         std::cout << "parameters of Hyundai ioniq 5: (" + optionName + ") is loaded" << std::endl;
+        ProfileTables::load();
     } else {
         std::cout << "Invalid brand or option" << std::endl;
     }
@@ -132,6 +69,78 @@ ElectricVehicleInit::ElectricVehicleInit(VehicleOption option, VehicleBrand bran
 
 ElectricVehicleInit::~ElectricVehicleInit() {}
 
+void ElectricVehicleInit::load(const VehicleProfile& profile) {
+    brand = profile.brand;
+    option = profile.option;
+    baseParam = profile.baseParam;
+    ProfileTables::load();
+}
+
+VehicleProfile ElectricVehicleInit::getProfile() {
+    VehicleProfile profile;
+    profile.brand = brand;
+    profile.option = option;
+    profile.baseParam = baseParam;
+    profile.tables = ProfileTables::current();
+    return profile;
+}
+
+std::shared_ptr<const VehicleProfile> VehicleProfile::create(VehicleBrand brand, VehicleOption option) {
+    const vehicleBaseParam* model = builtInDesign(brand, option);
+    if (model == nullptr) {
+        std::cerr << "Invalid brand or option" << std::endl;
+        return nullptr;
+    }
+
+    return create(brand, option, *model);
+}
+
+std::shared_ptr<const VehicleProfile> VehicleProfile::create(VehicleBrand brand, VehicleOption option,
+                                                            const vehicleBaseParam& baseParam,
+                                                            std::shared_ptr<const ProfileTables> tables) {
+    auto profile = std::make_shared<VehicleProfile>();
+    profile->brand = brand;
+    profile->option = option;
+    profile->baseParam = baseParam;
+    if (!tables) {
+        tables = std::make_shared<const ProfileTables>(profile->getDesignValue(VehicleAttribute::MAX_RPM),
+            profile->getDesignValue(VehicleAttribute::MAX_TORQUE), profile->getDesignValue(VehicleAttribute::WHEEL_RADIUS));
+    }
+    profile->tables = tables;
+    return profile;
+}
+
 bool strToBool(const std::string& str) {
     return (str == "1");
 }
+
+const char* attributeName(VehicleAttribute attribute) {
+    switch (attribute) {
+        case VehicleAttribute::ENGINE_TOTAL:        return "ENGINE_TOTAL";
+        case VehicleAttribute::BATTERY_CAPACITY:    return "BATTERY_CAPACITY";
+        case VehicleAttribute::BATTERY_VOLTAGE:     return "BATTERY_VOLTAGE";
+        case VehicleAttribute::MAX_RANGE:           return "MAX_RANGE";
+        case VehicleAttribute::MAX_TORQUE:          return "MAX_TORQUE";
+        case VehicleAttribute::MAX_ENGINE_POWER:    return "MAX_ENGINE_POWER";
+        case VehicleAttribute::MAX_AC_POWER:        return "MAX_AC_POWER";
+        case VehicleAttribute::MAX_SPEED_SPORT:     return "MAX_SPEED_SPORT";
+        case VehicleAttribute::MAX_SPEED_ECO:       return "MAX_SPEED_ECO";
+        case VehicleAttribute::MAX_RPM:             return "MAX_RPM";
+        case VehicleAttribute::WEIGHT:              return "WEIGHT";
+        case VehicleAttribute::WHEEL_RADIUS:        return "WHEEL_RADIUS";
+        case VehicleAttribute::AC_TEMP_MAX:         return "AC_TEMP_MAX";
+        case VehicleAttribute::AC_TEMP_MIN:         return "AC_TEMP_MIN";
+        case VehicleAttribute::WIND_LEVEL_MAX:      return "WIND_LEVEL_MAX";
+    }
+    return "UNKNOWN";
+}
+
+bool parseAttribute(const std::string& name, VehicleAttribute& attribute) {
+    for (int i = static_cast<int>(VehicleAttribute::ENGINE_TOTAL); i <= static_cast<int>(VehicleAttribute::WIND_LEVEL_MAX); i++) {
+        if (name == attributeName(static_cast<VehicleAttribute>(i))) {
+            attribute = static_cast<VehicleAttribute>(i);
+            return true;
+        }
+    }
+    return false;
+}
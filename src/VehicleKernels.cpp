@@ -0,0 +1,164 @@
+#include "VehicleKernels.h"
+#include "SimdKernels.h"
+#include "VehicleConfig.h"
+#include <atomic>
+
+// Reference implementation: the scalar VehicleCalculator functions in a loop
+static void scalarRpm(const KernelConstants&, const double* speed, size_t count, int wheelRadius, int maxRpm, double* out) {
+    for (size_t i = 0; i < count; i++) out[i] = VehicleCalculator::getRpm(speed[i], wheelRadius, maxRpm);
+}
+
+static void scalarTorque(const KernelConstants&, const double* rpm, const int32_t* gasLevel, size_t count, int maxRpm,
+                         int maxTorque, double* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = VehicleCalculator::getTorque(static_cast<int>(rpm[i]), maxRpm, gasLevel[i], maxTorque);
+    }
+}
+
+static void scalarTractiveForce(const KernelConstants&, const double* torque, size_t count, int wheelRadius, double* out) {
+    for (size_t i = 0; i < count; i++) out[i] = VehicleCalculator::getTractiveForce(wheelRadius, torque[i]);
+}
+
+static void scalarEnginePower(const KernelConstants&, const double* torque, const double* rpm, size_t count, double* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = VehicleCalculator::getPowerEngine(torque[i], VehicleCalculator::getAngularSpeed(static_cast<int>(rpm[i])));
+    }
+}
+
+static void scalarAirDragForce(const KernelConstants& k, const double* speed, size_t count, double* out) {
+    for (size_t i = 0; i < count; i++) out[i] = k.dragFactor * (speed[i] * speed[i]);
+}
+
+static void scalarAcceleration(const KernelConstants&, const double* speed, const double* traction,
+                               const int32_t* brakeLevel, size_t count, int weight, double* lastAcceleration, double* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = VehicleCalculator::getAcceleration(speed[i], traction[i], weight, brakeLevel[i], lastAcceleration[i]);
+    }
+}
+
+static void scalarBatteryTemp(const KernelConstants&, double* batteryTemp, const double* enginePower, size_t count,
+                              double envTemp) {
+    for (size_t i = 0; i < count; i++) {
+        batteryTemp[i] = VehicleCalculator::getBatteryTemp(batteryTemp[i], envTemp, enginePower[i]);
+    }
+}
+
+static void scalarCellTemp(const KernelConstants&, const double* temp, const double* heat, const double* cooling,
+                           size_t count, size_t stride, double heatScale, double conduction, double coolingScale,
+                           double coolantTemp, double* out) {
+    const double* up = temp - stride;
+    const double* down = temp + stride;
+    for (size_t i = 0; i < count; i++) {
+        double neighbours = (temp[i - 1] + temp[i + 1]) + (up[i] + down[i]);
+        double heated = (temp[i] + heatScale * heat[i]) + conduction * (neighbours - 4.0 * temp[i]);
+        out[i] = heated - coolingScale * cooling[i] * (temp[i] - coolantTemp);
+    }
+}
+
+static const KernelTable SCALAR_KERNELS = {
+    scalarRpm, scalarTorque, scalarTractiveForce, scalarEnginePower, scalarAirDragForce, scalarAcceleration,
+    scalarBatteryTemp, scalarCellTemp
+};
+
+const KernelConstants& VehicleKernels::constants() {
+    static const KernelConstants k = {
+        VehicleCalculator::PI,
+        VehicleCalculator::GR,
+        static_cast<double>(VehicleCalculator::GEAR_RATIO),
+        VehicleCalculator::EFFICIENCY_DRIVE,
+        VehicleCalculator::GRAVITY,
+        VehicleCalculator::US,
+        VehicleCalculator::CR,
+        VehicleCalculator::UK,
+        0.5 * VehicleCalculator::CD * VehicleCalculator::AIR_DENSITY * VehicleCalculator::AREA,
+        static_cast<double>(VehicleCalculator::C_COOLINGBASE),
+        static_cast<double>(VehicleCalculator::K_COOLING),
+        VehicleCalculator::T_ALPHA,
+        VehicleCalculator::T_BETA
+    };
+    return k;
+}
+
+static const KernelTable* tableFor(KernelIsa isa) {
+    const KernelTable* table = nullptr;
+    if (isa == KernelIsa::AVX2) table = getAvx2Kernels();
+    if (isa == KernelIsa::SSE2) table = getSse2Kernels();
+    return table ? table : &SCALAR_KERNELS;
+}
+
+static std::atomic<const KernelTable*> activeKernels{nullptr};
+static std::atomic<KernelIsa> activeIsa{KernelIsa::SCALAR};
+
+static const KernelTable& kernels() {
+    const KernelTable* table = activeKernels.load(std::memory_order_acquire);
+    if (!table) {
+        VehicleKernels::setIsa(VehicleKernels::detectIsa());
+        table = activeKernels.load(std::memory_order_acquire);
+    }
+    return *table;
+}
+
+KernelIsa VehicleKernels::detectIsa() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (getAvx2Kernels() && __builtin_cpu_supports("avx2")) return KernelIsa::AVX2;
+#endif
+    if (getSse2Kernels()) return KernelIsa::SSE2;
+    return KernelIsa::SCALAR;
+}
+
+void VehicleKernels::setIsa(KernelIsa isa) {
+    KernelIsa best = detectIsa();
+    if (isa == KernelIsa::AVX2 && best != KernelIsa::AVX2) isa = best;
+    if (isa == KernelIsa::SSE2 && best == KernelIsa::SCALAR) isa = best;
+    activeIsa.store(isa, std::memory_order_relaxed);
+    activeKernels.store(tableFor(isa), std::memory_order_release);
+}
+
+KernelIsa VehicleKernels::getIsa() {
+    kernels();
+    return activeIsa.load(std::memory_order_relaxed);
+}
+
+const char* VehicleKernels::isaName(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::AVX2: return "AVX2";
+        case KernelIsa::SSE2: return "SSE2";
+        default:              return "scalar";
+    }
+}
+
+void VehicleKernels::rpm(const double* speed, size_t count, int wheelRadius, int maxRpm, double* rpmOut) {
+    kernels().rpm(constants(), speed, count, wheelRadius, maxRpm, rpmOut);
+}
+
+void VehicleKernels::torque(const double* rpm, const int32_t* gasLevel, size_t count, int maxRpm, int maxTorque,
+                            double* torqueOut) {
+    kernels().torque(constants(), rpm, gasLevel, count, maxRpm, maxTorque, torqueOut);
+}
+
+void VehicleKernels::tractiveForce(const double* torque, size_t count, int wheelRadius, double* tractionOut) {
+    kernels().tractiveForce(constants(), torque, count, wheelRadius, tractionOut);
+}
+
+void VehicleKernels::enginePower(const double* torque, const double* rpm, size_t count, double* powerOut) {
+    kernels().enginePower(constants(), torque, rpm, count, powerOut);
+}
+
+void VehicleKernels::airDragForce(const double* speed, size_t count, double* dragOut) {
+    kernels().airDragForce(constants(), speed, count, dragOut);
+}
+
+void VehicleKernels::acceleration(const double* speed, const double* traction, const int32_t* brakeLevel, size_t count,
+                                  int weight, double* lastAcceleration, double* accelerationOut) {
+    kernels().acceleration(constants(), speed, traction, brakeLevel, count, weight, lastAcceleration, accelerationOut);
+}
+
+void VehicleKernels::batteryTemp(double* batteryTemp, const double* enginePower, size_t count, double envTemp) {
+    kernels().batteryTemp(constants(), batteryTemp, enginePower, count, envTemp);
+}
+
+void VehicleKernels::cellTemp(const double* temp, const double* heat, const double* cooling, size_t count, size_t stride,
+                              double heatScale, double conduction, double coolingScale, double coolantTemp, double* out) {
+    kernels().cellTemp(constants(), temp, heat, cooling, count, stride, heatScale, conduction, coolingScale, coolantTemp,
+                       out);
+}
@@ -0,0 +1,46 @@
+// Built with -mavx2 when the compiler supports it; only SimdKernels.h and
+// intrinsics are included here so no shared inline code is compiled for AVX2.
+#include "SimdKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    using V = __m256d;
+    static constexpr size_t WIDTH = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static V loadInt(const int32_t* p) { return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double x) { return _mm256_set1_pd(x); }
+    static V zero() { return _mm256_setzero_pd(); }
+
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V truncate(V a) { return _mm256_round_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+
+    static V lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static V gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static V eq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static V bitAnd(V a, V b) { return _mm256_and_pd(a, b); }
+    static V bitAndNot(V a, V b) { return _mm256_andnot_pd(a, b); }   // ~a & b
+    static V select(V mask, V ifTrue, V ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, mask); }
+};
+
+}
+
+const KernelTable* getAvx2Kernels() {
+    return SimdKernels<Avx2Ops>::table();
+}
+#else
+const KernelTable* getAvx2Kernels() {
+    return nullptr;
+}
+#endif
@@ -0,0 +1,46 @@
+#include "SimdKernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+namespace {
+
+struct Sse2Ops {
+    using V = __m128d;
+    static constexpr size_t WIDTH = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static V loadInt(const int32_t* p) { return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V set1(double x) { return _mm_set1_pd(x); }
+    static V zero() { return _mm_setzero_pd(); }
+
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V truncate(V a) { return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a)); }    // |a| < 2^31 here
+
+    static V lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V le(V a, V b) { return _mm_cmple_pd(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static V eq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static V bitAnd(V a, V b) { return _mm_and_pd(a, b); }
+    static V bitAndNot(V a, V b) { return _mm_andnot_pd(a, b); }   // ~a & b
+    static V select(V mask, V ifTrue, V ifFalse) {
+        return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+    }
+};
+
+}
+
+const KernelTable* getSse2Kernels() {
+    return SimdKernels<Sse2Ops>::table();
+}
+#else
+const KernelTable* getSse2Kernels() {
+    return nullptr;
+}
+#endif
@@ -0,0 +1,88 @@
+#include "VehicleSimulation.h"
+#include <cmath>
+
+VehicleSimulation::VehicleSimulation(DriveMode* driveMode, SafetyManager* safetyManager,
+                                     SpeedCalculator* speedCalculator, BatteryManager* batteryManager,
+                                     const DriverInputs& initialInputs)
+    : driveMode(driveMode), safetyManager(safetyManager), speedCalculator(speedCalculator),
+      batteryManager(batteryManager), ecoModeChanged(false) {
+    state.inputs = initialInputs;
+    state.speed = 0;
+    state.batteryLevel = batteryManager->getBatteryCapacity();
+    state.odometer = speedCalculator->getTotalDistance();
+    driveMode->setMode(initialInputs.driveMode);
+    state.outputPower = driveMode->getPowerOutput();
+}
+
+const VehicleState& VehicleSimulation::step(const DriverInputs& inputs) {
+    if (inputs.driveMode != state.inputs.driveMode) {
+        driveMode->setMode(inputs.driveMode);
+        ecoModeChanged = (inputs.driveMode == DriveMode::Mode::ECO);
+    }
+    state.inputs = inputs;
+    state.outputPower = driveMode->getPowerOutput();
+
+    batteryManager->updateBatteryCapacity(inputs.acTemp, inputs.windLevel);
+    state.batteryLevel = batteryManager->getBatteryCapacity();
+    state.remainingRange = batteryManager->calculateRemainingRange();
+    state.batteryTemp = batteryManager->calculateBatteryTemp();
+    state.odometer = speedCalculator->getTotalDistance();
+
+    if (ecoModeChanged) {
+        if (state.speed > speedCalculator->getMaxSpeed("ECO")) {
+            state.speed = driveMode->limitSpeedECO(state.speed);
+        } else {
+            ecoModeChanged = false;
+        }
+    } else {
+        state.speed = speedCalculator->calculateSpeed(inputs.isAccelerator, inputs.isBrake);
+    }
+
+    batteryManager->updateRangeDistribution(inputs);
+    RangePercentiles percentiles = batteryManager->getRangePercentiles();
+    state.rangeP10 = percentiles.p10;
+    state.rangeP50 = percentiles.p50;
+    state.rangeP90 = percentiles.p90;
+
+    state.isSafetyAction = safetyManager->isBrakeAndAcceleratorCoincidence(inputs.isBrake, inputs.isAccelerator);
+    state.brakeIntensity = safetyManager->getBrakeIntensity();
+    state.gasIntensity = safetyManager->getAcceleratorIntensity();
+    state.tick++;
+    return state;
+}
+
+SignalBatch StoredSignals::changes(const VehicleState& state) {
+    SignalBatch updates;
+    if (std::abs(state.speed - speed) >= 1) {
+        updates.set(SignalId::VEHICLE_SPEED, state.speed);
+        speed = state.speed;
+    }
+    if (std::abs(state.odometer - odometer) >= 0.1) {
+        updates.set(SignalId::ODOMETER, state.odometer);
+        odometer = static_cast<int>(state.odometer);
+    }
+    if (std::abs(state.batteryLevel - batteryLevel) >= 1) {
+        updates.set(SignalId::BATTERY_LEVEL, static_cast<int>(state.batteryLevel));
+        batteryLevel = static_cast<int>(state.batteryLevel);
+    }
+    if (std::abs(state.remainingRange - remainingRange) >= 0.1) {
+        updates.set(SignalId::ROUTE_PLANNER, static_cast<int>(state.remainingRange));
+        remainingRange = static_cast<int>(state.remainingRange);
+    }
+    if (std::abs(state.batteryTemp - batteryTemp) >= 0.1) {
+        updates.set(SignalId::BATTERY_TEMP, static_cast<int>(state.batteryTemp));
+        batteryTemp = static_cast<int>(state.batteryTemp);
+    }
+    return updates;
+}
+
+DriverInputs inputsFromFrame(const SignalFrame& frame, DriverInputs inputs) {
+    if (frame.has(SignalId::DRIVE_MODE)) {
+        inputs.driveMode = frame.get(SignalId::DRIVE_MODE) == DRIVE_MODE_SPORT ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO;
+    }
+    if (frame.has(SignalId::AC_STATUS))     inputs.acStatus = frame.getBool(SignalId::AC_STATUS);
+    if (frame.has(SignalId::AC_CONTROL))    inputs.acTemp = frame.getInt(SignalId::AC_CONTROL);
+    if (frame.has(SignalId::WIND_LEVEL))    inputs.windLevel = frame.getInt(SignalId::WIND_LEVEL);
+    if (frame.has(SignalId::TURN_SIGNAL))   inputs.turnSignal = frame.getInt(SignalId::TURN_SIGNAL);
+    return inputs;
+}
@@ -6,13 +6,21 @@
 #include "DriveMode.h"
 #include "BatteryManager.h"
 #include "SpeedCalculator.h"
+#include "VehicleState.h"
+#include "TelemetryRecorder.h"
+#include "VehicleSimulation.h"
+#include "SimulationClock.h"
+#include "ProfileCatalog.h"
+#include "ThreadPool.h"
 #include <thread>
 #include <atomic>
-#include <mutex>
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <chrono>
+#include <csignal>
+#include <cmath>
+#include <cstdlib>
 
 void setTerminalRawMode(bool enable) {
     static struct termios oldt, newt;
@@ -52,44 +60,115 @@ void setNonBlocking(bool enable) {
     }
 }
 
-std::mutex shareMutex;
+// Cleared by SIGINT so every thread leaves its loop and main can flush the store
+std::atomic<bool> isRunning(true);
 
-// Atomic variables for thread-safe access without locks
-std::atomic<int> acTemp(0), odometer(0), windLevel(0), remainingRange(0);
-std::atomic<int> currentSpeed(0), batteryLevel(0), batteryTemp(0), turnSignal(0);
-std::atomic<bool> acStatus(false), brakeStatus(false), acceleratorStatus(false), ecoModeChanged(false);
+void handleSignal(int) {
+    isRunning = false;
+}
 
-std::string driveMode = "ECO";
+// Driver controls are written only by the input thread and the vehicle state
+// only by the physics loop; readers get consistent snapshots without locks
+DriverInputChannel driverInputs;
+VehicleStateChannel vehicleState;
 
-void vehicleInit(DataHandler* handler);
+void vehicleInit(DataHandler* handler, SpeedCalculator* speedCalculator, BatteryManager* batteryManager);
 void readData(DataHandler* handler, DashboardController* dashboardController);
-void inputHandler(DataHandler* handler, SafetyManager* safetyManager, DriveMode* driveModeHandler);
-void mainLoop(DataHandler* dataHandler, Display* display, 
-              SpeedCalculator* speedCalculator, BatteryManager* batteryManager, DriveMode* driveModeHandler);
+void inputHandler(DataHandler* handler);
+void mainLoop(DataHandler* dataHandler, Display* display, SafetyManager* safetyManager,
+              SpeedCalculator* speedCalculator, BatteryManager* batteryManager, DriveMode* driveModeHandler,
+              TelemetryRecorder* recorder, SimulationClock* clock, ProfileWatcher* profileWatcher);
+
+int main(int argc, char* argv[]) {
+    // --storage mapped|journal selects another backend than the CSV file
+    StorageBackend backend = StorageBackend::CSV;
+    // --record <file> sets the trip telemetry log, --no-record disables it
+    std::string telemetryPath = "../data/Trip.telemetry";
+    // --clock fixed|accelerated and --time-scale <N> decouple the physics from the wall clock
+    SimulationClock::Mode clockMode = SimulationClock::Mode::REAL_TIME;
+    double timeScale = 1.0;
+    // --integrator semi-implicit|rk4|rk45 replaces the per-tick Euler step of the speed
+    IntegratorMethod integrator = IntegratorMethod::EULER;
+    // --pack-cells <N> replaces the lumped battery temperature with N cell temperatures
+    int packCells = 0;
+    // --catalog <file> and --profile <name> pick the vehicle from a profile catalog, reloaded when the file changes
+    std::string catalogPath;
+    std::string profileName;
+    // --range-samples <N> sizes the Monte Carlo range distribution, 0 turns it off
+    size_t rangeSamples = MonteCarloRange::DEFAULT_SAMPLES;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--no-record") telemetryPath.clear();
+        if (i + 1 >= argc) continue;
+        if (arg == "--record") telemetryPath = argv[i + 1];
+        if (arg == "--time-scale") timeScale = std::atof(argv[i + 1]);
+        if (arg == "--pack-cells") packCells = std::atoi(argv[i + 1]);
+        if (arg == "--catalog") catalogPath = argv[i + 1];
+        if (arg == "--profile") profileName = argv[i + 1];
+        if (arg == "--range-samples") rangeSamples = std::strtoul(argv[i + 1], nullptr, 10);
+        if (arg == "--integrator" && !Integrator::parseMethod(argv[i + 1], integrator)) {
+            std::cerr << "Unknown integrator " << argv[i + 1] << ", using euler" << std::endl;
+        }
+        if (arg == "--clock" && std::string(argv[i + 1]) == "fixed")        clockMode = SimulationClock::Mode::FIXED_STEP;
+        if (arg == "--clock" && std::string(argv[i + 1]) == "accelerated")  clockMode = SimulationClock::Mode::ACCELERATED;
+        if (arg != "--storage") continue;
+        if (std::string(argv[i + 1]) == "mapped")   backend = StorageBackend::MAPPED;
+        if (std::string(argv[i + 1]) == "journal")  backend = StorageBackend::JOURNAL;
+    }
+
+    ProfileWatcher* profileWatcher = nullptr;
+    if (!catalogPath.empty() || !profileName.empty()) {
+        if (catalogPath.empty()) catalogPath = ProfileCatalog::DEFAULT_PATH;
+        if (profileName.empty()) profileName = "tesla-long-range";
+        std::shared_ptr<const ProfileCatalog> catalog = ProfileCatalog::load(catalogPath);
+        int index = catalog ? catalog->find(profileName) : -1;
+        if (index < 0) {
+            std::cerr << "No profile " << profileName << " in " << catalogPath << std::endl;
+            return 1;
+        }
+        std::shared_ptr<const VehicleProfile> profile = catalog->createProfile(index);
+        ElectricVehicleInit::load(*profile);
+        std::cout << "parameters of " << profileName << " loaded from " << catalogPath << std::endl;
+        profileWatcher = new ProfileWatcher(catalogPath, profileName, profile);
+    } else {
+        ElectricVehicleInit TeslaModel3(VehicleOption::LONG_RANGE, VehicleBrand::TESLA);
+    }
+    ElectricVehicleInit::displayVehicleInfo();
 
-int main() {
     setTerminalRawMode(true);
     setNonBlocking(true);
+    std::signal(SIGINT, handleSignal);
 
-    DataHandler* dataHandler = DataHandler::getInstance();
-
-    ElectricVehicleInit TeslaModel3(VehicleOption::LONG_RANGE, VehicleBrand::TESLA);
-    TeslaModel3.displayVehicleInfo();
+    DataHandler* dataHandler = DataHandler::getInstance(backend);
 
     DashboardController* dashboardController = new DashboardController();
-    Display* display = new Display(dashboardController);
+    Display* display = new Display(dashboardController, &vehicleState);
     SafetyManager* safetyManager = new SafetyManager();
     DriveMode* driveModeHandler = new DriveMode();
-    SpeedCalculator* speedCalculator = new SpeedCalculator(driveModeHandler, safetyManager);
-    BatteryManager* batteryManager = new BatteryManager(speedCalculator);
+    SimulationClock* simulationClock = new SimulationClock(clockMode, SimulationClock::DEFAULT_STEP, timeScale);
+    SpeedCalculator* speedCalculator = new SpeedCalculator(driveModeHandler, safetyManager, simulationClock);
+    BatteryManager* batteryManager = new BatteryManager(speedCalculator, simulationClock);
+    speedCalculator->setIntegrator(integrator);
+    if (packCells > 0) {
+        PackThermalConfig packConfig;
+        packConfig.cellCount = packCells;
+        batteryManager->enablePackModel(packConfig);
+    }
+    ThreadPool* rangePool = nullptr;
+    if (rangeSamples > 0) {
+        rangePool = new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+        batteryManager->enableRangeDistribution(rangePool, rangeSamples);
+    }
+    TelemetryRecorder* recorder = telemetryPath.empty() ? nullptr : new TelemetryRecorder(telemetryPath);
 
-    vehicleInit(dataHandler);
+    vehicleInit(dataHandler, speedCalculator, batteryManager);
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
     std::thread dataThread(readData, dataHandler, dashboardController);
-    std::thread inputThread(inputHandler, dataHandler, safetyManager, driveModeHandler);
+    std::thread inputThread(inputHandler, dataHandler);
 
-    mainLoop(dataHandler, display, speedCalculator, batteryManager, driveModeHandler);
+    mainLoop(dataHandler, display, safetyManager, speedCalculator, batteryManager, driveModeHandler, recorder,
+             simulationClock, profileWatcher);
 
     dataThread.join();
     inputThread.join();
@@ -97,226 +176,248 @@ int main() {
     setTerminalRawMode(false);
     setNonBlocking(false);
 
-    delete speedCalculator;
+    dataHandler->shutdown();
+    if (dataHandler->getBackend() == StorageBackend::MAPPED) {
+        dataHandler->exportCsv("../data/Database.csv");
+    }
+    DataHandlerStats stats = dataHandler->getStats();
+    std::cout << "DataHandler: " << stats.updateCalls << " updates, " << stats.keyWrites << " key writes, "
+              << stats.coalescedWrites << " coalesced, " << stats.flushCount << " flushes, avg flush "
+              << (stats.flushCount ? stats.totalFlushMs / stats.flushCount : 0.0) << " ms, max flush "
+              << stats.maxFlushMs << " ms" << std::endl;
+    std::cout << "Writer queue: " << stats.commandsEnqueued << " commands, max depth " << stats.maxQueueDepth
+              << ", " << stats.queueFullWaits << " full waits, " << stats.batchCount << " batches, avg batch "
+              << (stats.batchCount ? static_cast<double>(stats.commandsEnqueued) / stats.batchCount : 0.0)
+              << ", max batch " << stats.maxBatchSize << std::endl;
+    std::cout << "DashboardController: " << dashboardController->getReads() << " reads, "
+              << dashboardController->getNotifications() << " notified" << std::endl;
+    dataHandler->getDurableLatency().print(std::cout, "Enqueue-to-durable latency");
+    dataHandler->getNotifyLatency().print(std::cout, "Change-to-notify latency");
+    if (recorder) {
+        recorder->close();
+        TelemetryStats telemetry = recorder->getStats();
+        std::cout << "Telemetry: " << telemetry.samplesWritten << " samples in " << telemetry.blocksWritten
+                  << " blocks, " << telemetry.samplesDropped << " dropped, " << telemetry.encodedBytes
+                  << " bytes (" << telemetry.compressionRatio() << "x smaller) -> " << recorder->getPath() << std::endl;
+    }
+
+    delete profileWatcher;
+    delete recorder;
     delete batteryManager;
+    delete rangePool;
+    delete speedCalculator;
+    delete simulationClock;
+    delete display;
     delete dashboardController;
     delete dataHandler;
     delete safetyManager;
     delete driveModeHandler;
-    delete display;
 
     return 0;
 }
 
-void vehicleInit(DataHandler* dataHandler) {
-    static const int MAX_RANGE = ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RANGE);
-    
-    {
-        std::lock_guard<std::mutex> lock(shareMutex);
-        dataHandler->updateData({
-            {"VEHICLE_SPEED", "0"},
-            {"DRIVE_MODE", "ECO"},
-            {"WIND_LEVEL", "2"},
-            {"BATTERY_LEVEL", "100"},
-            {"AC_STATUS", "1"},
-            {"AC_CONTROL", "22"},
-            {"BATTERY_TEMP", "35"},
-            {"BRAKE", "0"},
-            {"ACCELERATOR", "0"},
-            {"ODOMETER", "0"},
-            {"ROUTE_PLANNER", std::to_string(MAX_RANGE)},
-            {"TURN_SIGNAL", "0"}
+void vehicleInit(DataHandler* dataHandler, SpeedCalculator* speedCalculator, BatteryManager* batteryManager) {
+    if (dataHandler->hasRecoveredState()) {
+        // Resume from the recovered journal: only the driver inputs start released
+        SignalFrame recovered = dataHandler->readSignals();
+        if (recovered.has(SignalId::BATTERY_LEVEL)) batteryManager->restoreBatteryLevel(recovered.get(SignalId::BATTERY_LEVEL));
+        if (recovered.has(SignalId::ODOMETER))      speedCalculator->restoreDistance(recovered.get(SignalId::ODOMETER));
+
+        dataHandler->updateSignals({
+            {SignalId::VEHICLE_SPEED, 0},
+            {SignalId::BRAKE, 0},
+            {SignalId::ACCELERATOR, 0},
+            {SignalId::TURN_SIGNAL, 0}
         });
+        driverInputs.store(inputsFromFrame(dataHandler->readSignals(), DriverInputs()));
+        std::cout << "Vehicle state recovered from journal" << std::endl;
+        return;
     }
+
+    dataHandler->updateSignals({
+        {SignalId::VEHICLE_SPEED, 0},
+        {SignalId::DRIVE_MODE, DRIVE_MODE_ECO},
+        {SignalId::WIND_LEVEL, 2},
+        {SignalId::BATTERY_LEVEL, 100},
+        {SignalId::AC_STATUS, 1},
+        {SignalId::AC_CONTROL, 22},
+        {SignalId::BATTERY_TEMP, 35},
+        {SignalId::BRAKE, 0},
+        {SignalId::ACCELERATOR, 0},
+        {SignalId::ODOMETER, 0},
+        {SignalId::ROUTE_PLANNER, static_cast<double>(ElectricVehicleInit::getDesignValue(VehicleAttribute::MAX_RANGE))},
+        {SignalId::TURN_SIGNAL, 0}
+    });
+    driverInputs.store(inputsFromFrame(dataHandler->readSignals(), DriverInputs()));
 }
 
 void readData(DataHandler* handler, DashboardController* dashboardController) {
-    while (true) {
-        std::unordered_map<std::string, std::string> allData;
-        {
-            std::lock_guard<std::mutex> lock(shareMutex);
-            allData = handler->readData();
-            if (allData.count("DRIVE_MODE")) {
-                driveMode = allData["DRIVE_MODE"];
-                if (driveMode == "ECO") {
-                    ecoModeChanged = true;
-                }
-            }
-        }
-        dashboardController->readData(allData);
-        
-        try {
-            if (allData.count("AC_CONTROL"))    acTemp = std::stoi(allData.at("AC_CONTROL"));
-            if (allData.count("WIND_LEVEL"))    windLevel = std::stoi(allData.at("WIND_LEVEL"));
-            if (allData.count("TURN_SIGNAL"))   turnSignal = std::stoi(allData.at("TURN_SIGNAL"));
-            if (allData.count("ODOMETER"))      odometer = std::stoi(allData.at("ODOMETER"));
-            if (allData.count("BATTERY_TEMP"))  batteryTemp = std::stoi(allData.at("BATTERY_TEMP"));
-            if (allData.count("VEHICLE_SPEED")) currentSpeed = std::stoi(allData.at("VEHICLE_SPEED"));
-            if (allData.count("BATTERY_LEVEL")) batteryLevel = std::stoi(allData.at("BATTERY_LEVEL"));
-            if (allData.count("ROUTE_PLANNER")) remainingRange = std::stoi(allData.at("ROUTE_PLANNER"));
-            if (allData.count("BRAKE"))         brakeStatus = (allData.at("BRAKE") == "1");
-            if (allData.count("ACCELERATOR"))   acceleratorStatus = (allData.at("ACCELERATOR") == "1");
-            if (allData.count("AC_STATUS"))     acStatus = (allData.at("AC_STATUS") == "1");
-        } catch (const std::exception& e) {
-            std::cerr << "Error in readData: " << e.what() << std::endl;
+    uint64_t seenVersion = 0;
+    bool firstRead = true;
+    while (isRunning) {
+        // Sleep until DataHandler commits a change or the backing file is edited externally
+        if (!handler->waitForChange(seenVersion, std::chrono::milliseconds(500)) && !firstRead) {
+            continue;
         }
-         
-        std::this_thread::sleep_for(std::chrono::milliseconds(120));
+        firstRead = false;
+        dashboardController->readData(handler->readSignals());
     }
 }
 
 enum class KeyState { RELEASED, PRESSED };
 
-void inputHandler(DataHandler* handler, SafetyManager* safetyManager, DriveMode* driveModeHandler) {
+void inputHandler(DataHandler* handler) {
     const int AC_MIN = ElectricVehicleInit::getDesignValue(VehicleAttribute::AC_TEMP_MIN);
     const int AC_MAX = ElectricVehicleInit::getDesignValue(VehicleAttribute::AC_TEMP_MAX);
     const int MAX_WIND_LEVEL = ElectricVehicleInit::getDesignValue(VehicleAttribute::WIND_LEVEL_MAX);
 
     std::unordered_map<char, bool> keyStates = {{'w', false}, {'s', false}};
+    DriverInputs inputs = driverInputs.load();
+    uint64_t seenVersion = handler->getVersion();
     char ch;
     
-    while (true) {
+    while (isRunning) {
         keyStates['w'] = false;
         keyStates['s'] = false;
 
-        {
-            std::lock_guard<std::mutex> lock(shareMutex);
-            while (read(STDIN_FILENO, &ch, 1) > 0) {
-                switch (ch) {
-                    case 'c': // Increase AC temperature
-                        if (acStatus) {
-                            if (acTemp < AC_MAX) acTemp++;
-                            handler->updateData({{"AC_CONTROL", std::to_string(acTemp)}});
-                        }
-                        break;
-                        
-                    case 'z': // Decrease AC temperature
-                        if (acStatus) {
-                            if (acTemp > AC_MIN) acTemp--;
-                            handler->updateData({{"AC_CONTROL", std::to_string(acTemp)}});
-                        }
-                        break;
-                        
-                    case 'x': // Toggle AC status
-                        acStatus = !acStatus;
-                        handler->updateData({
-                            {"AC_STATUS", acStatus ? "1" : "0"},
-                            {"AC_CONTROL", acStatus ? "22" : "0"}
-                        });
-                        break;
-                        
-                    case 'a': // Adjust wind level
-                        if (acStatus) {
-                            windLevel = (windLevel < MAX_WIND_LEVEL) ? windLevel + 1 : 0;
-                            handler->updateData({{"WIND_LEVEL", std::to_string(windLevel)}});
-                        }
-                        break;
-                        
-                    case 'd': // Toggle drive mode
-                        if (driveMode == "ECO") {
-                            handler->updateData({{"DRIVE_MODE", "SPORT"}});
-                            driveModeHandler->setMode(DriveMode::Mode::SPORT);
-                            driveMode = "SPORT";
-                        } else {
-                            ecoModeChanged = true;
-                            handler->updateData({{"DRIVE_MODE", "ECO"}});
-                            driveModeHandler->setMode(DriveMode::Mode::ECO);
-                            driveMode = "ECO";
-                        }
-                        outputPower = driveModeHandler->getPowerOutput();
-                        break;
-                        
-                    case 'q': // Left turn signal
-                        turnSignal = (turnSignal == 1) ? 0 : 1;
-                        handler->updateData({{"TURN_SIGNAL", std::to_string(turnSignal)}});
-                        break;
-                        
-                    case 'e': // Right turn signal
-                        turnSignal = (turnSignal == 2) ? 0 : 2;
-                        handler->updateData({{"TURN_SIGNAL", std::to_string(turnSignal)}});
-                        break;
-                        
-                    case 'w': // Accelerator
-                        keyStates['w'] = true;
-                        break;
-                        
-                    case 's': // Brake
-                        keyStates['s'] = true;
-                        break;
-                }
-            }
+        // Pick up controls edited in the backing file by another program
+        uint64_t version = handler->getVersion();
+        if (version != seenVersion) {
+            inputs = inputsFromFrame(handler->readSignals(), inputs);
+            seenVersion = version;
+        }
 
-            // Update accelerator and brake status
-            bool newAcceleratorStatus = keyStates['w'];
-            if (acceleratorStatus != newAcceleratorStatus) {
-                acceleratorStatus = newAcceleratorStatus;
-                handler->updateData({{"ACCELERATOR", acceleratorStatus ? "1" : "0"}});
-            }
-            bool newBrakeStatus = keyStates['s'];
-            if (brakeStatus != newBrakeStatus) {
-                brakeStatus = newBrakeStatus;
-                handler->updateData({{"BRAKE", brakeStatus ? "1" : "0"}});
+        while (read(STDIN_FILENO, &ch, 1) > 0) {
+            switch (ch) {
+                case 'c': // Increase AC temperature
+                    if (inputs.acStatus) {
+                        if (inputs.acTemp < AC_MAX) inputs.acTemp++;
+                        handler->updateSignals({{SignalId::AC_CONTROL, static_cast<double>(inputs.acTemp)}});
+                    }
+                    break;
+                    
+                case 'z': // Decrease AC temperature
+                    if (inputs.acStatus) {
+                        if (inputs.acTemp > AC_MIN) inputs.acTemp--;
+                        handler->updateSignals({{SignalId::AC_CONTROL, static_cast<double>(inputs.acTemp)}});
+                    }
+                    break;
+                    
+                case 'x': // Toggle AC status
+                    inputs.acStatus = !inputs.acStatus;
+                    inputs.acTemp = inputs.acStatus ? 22 : 0;
+                    handler->updateSignals({
+                        {SignalId::AC_STATUS, inputs.acStatus ? 1.0 : 0.0},
+                        {SignalId::AC_CONTROL, static_cast<double>(inputs.acTemp)}
+                    });
+                    break;
+                    
+                case 'a': // Adjust wind level
+                    if (inputs.acStatus) {
+                        inputs.windLevel = (inputs.windLevel < MAX_WIND_LEVEL) ? inputs.windLevel + 1 : 0;
+                        handler->updateSignals({{SignalId::WIND_LEVEL, static_cast<double>(inputs.windLevel)}});
+                    }
+                    break;
+                    
+                case 'd': // Toggle drive mode
+                    if (inputs.driveMode == DriveMode::Mode::ECO) {
+                        inputs.driveMode = DriveMode::Mode::SPORT;
+                        handler->updateSignals({{SignalId::DRIVE_MODE, DRIVE_MODE_SPORT}});
+                    } else {
+                        inputs.driveMode = DriveMode::Mode::ECO;
+                        handler->updateSignals({{SignalId::DRIVE_MODE, DRIVE_MODE_ECO}});
+                    }
+                    break;
+                    
+                case 'q': // Left turn signal
+                    inputs.turnSignal = (inputs.turnSignal == 1) ? 0 : 1;
+                    handler->updateSignals({{SignalId::TURN_SIGNAL, static_cast<double>(inputs.turnSignal)}});
+                    break;
+                    
+                case 'e': // Right turn signal
+                    inputs.turnSignal = (inputs.turnSignal == 2) ? 0 : 2;
+                    handler->updateSignals({{SignalId::TURN_SIGNAL, static_cast<double>(inputs.turnSignal)}});
+                    break;
+                    
+                case 'w': // Accelerator
+                    keyStates['w'] = true;
+                    break;
+                    
+                case 's': // Brake
+                    keyStates['s'] = true;
+                    break;
             }
         }
 
-        isSafetyAction = safetyManager->isBrakeAndAcceleratorCoincidence(brakeStatus, acceleratorStatus);
-        brakeIntensityDisplay = safetyManager->getBrakeIntensity();
-        gasIntensityDisplay = safetyManager->getAcceleratorIntensity();
+        // Update accelerator and brake status
+        bool newAcceleratorStatus = keyStates['w'];
+        if (inputs.isAccelerator != newAcceleratorStatus) {
+            inputs.isAccelerator = newAcceleratorStatus;
+            handler->updateSignals({{SignalId::ACCELERATOR, inputs.isAccelerator ? 1.0 : 0.0}});
+        }
+        bool newBrakeStatus = keyStates['s'];
+        if (inputs.isBrake != newBrakeStatus) {
+            inputs.isBrake = newBrakeStatus;
+            handler->updateSignals({{SignalId::BRAKE, inputs.isBrake ? 1.0 : 0.0}});
+        }
+
+        driverInputs.store(inputs);
+        seenVersion = handler->getVersion();
         
         std::this_thread::sleep_for(std::chrono::milliseconds(25));
     }
 }
 
-void mainLoop(DataHandler* dataHandler, Display* display, 
-              SpeedCalculator* speedCalculator, BatteryManager* batteryManager, DriveMode* driveModeHandler) {
-    int updateSpeed = 0;
-    outputPower = driveModeHandler->getPowerOutput();
+void mainLoop(DataHandler* dataHandler, Display* display, SafetyManager* safetyManager,
+              SpeedCalculator* speedCalculator, BatteryManager* batteryManager, DriveMode* driveModeHandler,
+              TelemetryRecorder* recorder, SimulationClock* clock, ProfileWatcher* profileWatcher) {
+    VehicleSimulation simulation(driveModeHandler, safetyManager, speedCalculator, batteryManager, driverInputs.load());
+    VehicleState state = simulation.getState();
+    vehicleState.store(state);
+
+    StoredSignals stored;
+    stored.odometer = static_cast<int>(state.odometer);
+    // Telemetry timestamps follow simulated time, so a replay sees the same steps
+    int64_t startMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
     
-    while (true) {
+    while (isRunning) {
         display->updateDisplay();
-        
-        batteryManager->updateBatteryCapacity(acTemp, windLevel);
-        double updateBatteryCapacity = batteryManager->getBatteryCapacity();
-        double updateRemainingRange = batteryManager->calculateRemainingRange();
-        updateBatteryTemp = batteryManager->calculateBatteryTemp();
-        updateOdometer = speedCalculator->getTotalDistance();
-
-        if (ecoModeChanged) {
-            if (updateSpeed > speedCalculator->getMaxSpeed("ECO")) {
-                updateSpeed = driveModeHandler->limitSpeedECO(updateSpeed);
-            } else {
-                ecoModeChanged = false;
-            }
-        } else {
-            updateSpeed = speedCalculator->calculateSpeed(acceleratorStatus, brakeStatus);
-        }
-        
-        std::unordered_map<std::string, std::string> updates;
-        if (std::abs(updateSpeed - currentSpeed) >= 1) {
-            updates["VEHICLE_SPEED"] = std::to_string(updateSpeed);
-            currentSpeed = updateSpeed;
-        }
-        if (std::abs(updateOdometer - odometer) >= 0.1) {
-            updates["ODOMETER"] = std::to_string(updateOdometer);
-            odometer = updateOdometer;
-        }
-        if (std::abs(updateBatteryCapacity - batteryLevel) >= 1) {
-            updates["BATTERY_LEVEL"] = std::to_string(static_cast<int>(updateBatteryCapacity));
-            batteryLevel = static_cast<int>(updateBatteryCapacity);
-        }
-        if (std::abs(updateRemainingRange - remainingRange) >= 0.1) {
-            updates["ROUTE_PLANNER"] = std::to_string(static_cast<int>(updateRemainingRange));
-            remainingRange = static_cast<int>(updateRemainingRange);
+
+        // A reloaded profile takes effect between ticks; speed, charge and odometer carry over
+        std::shared_ptr<const VehicleProfile> profile = profileWatcher ? profileWatcher->takeUpdate() : nullptr;
+        if (profile) {
+            driveModeHandler->setProfile(*profile);
+            speedCalculator->setProfile(*profile);
+            batteryManager->setProfile(*profile);
         }
-        if (std::abs(updateBatteryTemp - batteryTemp) >= 0.1) {
-            updates["BATTERY_TEMP"] = std::to_string(static_cast<int>(updateBatteryTemp));
-            batteryTemp = static_cast<int>(updateBatteryTemp);
+
+        // Battery and speed integrate over the same tick time
+        clock->tick();
+        DriverInputs inputs = driverInputs.load();
+        state = simulation.step(inputs);
+        vehicleState.store(state);
+
+        if (recorder) {
+            TelemetrySample sample;
+            sample.timestampMicros = startMicros + std::llround(clock->getTime() * 1e6);
+            sample.speed = state.speed;
+            sample.gasIntensity = state.gasIntensity;
+            sample.brakeIntensity = state.brakeIntensity;
+            sample.inputFlags = packInputFlags(inputs);
+            sample.acTemp = inputs.acTemp;
+            sample.windLevel = inputs.windLevel;
+            sample.powerConsumption = speedCalculator->getPowerConsumption();
+            sample.currentKwH = batteryManager->getBatteryKwH();
+            sample.batteryTemp = state.batteryTemp;
+            sample.odometer = state.odometer;
+            recorder->record(sample);
         }
         
+        SignalBatch updates = stored.changes(state);
         if (!updates.empty()) {
-            std::lock_guard<std::mutex> lock(shareMutex);
-            dataHandler->updateData(updates);
+            dataHandler->updateSignals(updates);
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(60));
     }
-}
\ No newline at end of file
+}
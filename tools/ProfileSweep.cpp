@@ -0,0 +1,238 @@
+// Evaluates every combination of design values in the given ranges on all
+// cores: a full-throttle SPORT launch for 0-100 km/h and top speed, then an
+// ECO stop-and-go cycle with the AC on for kWh/km and range.
+//
+//     ./ProfileSweep [--base tesla-standard|tesla-long-range|ioniq5|ioniq5-performance] [--threads N]
+//                    [--csv <file>] [ATTRIBUTE=min:max:step | ATTRIBUTE=value ...]
+//
+// Without ranges it sweeps BATTERY_CAPACITY=50:100:10 MAX_TORQUE=300:700:100 WEIGHT=1500:2300:200
+// WHEEL_RADIUS=32:38:2 around the base profile.
+#include "BatteryManager.h"
+#include "ProfileTables.h"
+#include "ThreadPool.h"
+#include "VehicleConfig.h"
+#include "VehicleSimulation.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+static const double LAUNCH_SECONDS = 90.0;
+static const int CYCLE_SECONDS = 70;
+static const int CYCLES = 14;
+static const size_t MAX_COMBINATIONS = 1000000;
+
+struct SweepRange {
+    VehicleAttribute attribute;
+    int min;
+    int max;
+    int step;
+
+    size_t count() const { return static_cast<size_t>((max - min) / step) + 1; }
+};
+
+struct SweepResult {
+    double zeroTo100 = -1.0;    // s, negative if 100 km/h was never reached
+    int topSpeed = 0;           // km/h
+    double kwhPerKm = 0.0;
+    double range = 0.0;         // km on a full battery at that consumption
+};
+
+struct Vehicle {
+    SimulationClock clock;
+    DriveMode driveMode;
+    SafetyManager safetyManager;
+    SpeedCalculator speedCalculator;
+    BatteryManager batteryManager;
+    VehicleSimulation simulation;
+
+    Vehicle(const VehicleProfile& profile, const DriverInputs& inputs)
+        : clock(SimulationClock::Mode::FIXED_STEP), driveMode(profile),
+          speedCalculator(&driveMode, &safetyManager, &clock, profile),
+          batteryManager(&speedCalculator, &clock, profile),
+          simulation(&driveMode, &safetyManager, &speedCalculator, &batteryManager, inputs) {}
+};
+
+static bool parseRange(const std::string& arg, SweepRange& range) {
+    size_t equals = arg.find('=');
+    if (equals == std::string::npos || !parseAttribute(arg.substr(0, equals), range.attribute)) {
+        return false;
+    }
+    std::string values = arg.substr(equals + 1);
+    size_t first = values.find(':');
+    range.min = std::atoi(values.c_str());
+    range.max = range.min;
+    range.step = 1;
+    if (first != std::string::npos) {
+        size_t second = values.find(':', first + 1);
+        range.max = std::atoi(values.c_str() + first + 1);
+        if (second != std::string::npos) range.step = std::atoi(values.c_str() + second + 1);
+    }
+    return range.step > 0 && range.min <= range.max && range.min > 0 && range.max <= INT16_MAX;
+}
+
+static SweepResult evaluate(const VehicleProfile& profile) {
+    SweepResult result;
+
+    DriverInputs launch;
+    launch.driveMode = DriveMode::Mode::SPORT;
+    launch.isAccelerator = true;
+    Vehicle fast(profile, launch);
+    int previousSpeed = 0;
+    while (fast.clock.getTime() < LAUNCH_SECONDS) {
+        fast.clock.tick();
+        int speed = fast.simulation.step(launch).speed;
+        if (speed >= 100 && previousSpeed < 100 && result.zeroTo100 < 0.0) {
+            double step = fast.clock.getDeltaTime();
+            result.zeroTo100 = fast.clock.getTime() - step + step * (100 - previousSpeed) / (speed - previousSpeed);
+        }
+        result.topSpeed = std::max(result.topSpeed, speed);
+        previousSpeed = speed;
+    }
+
+    // The ReplayTrip --synthetic cycle: accelerate 30 s, coast 20 s, brake 10 s, idle 10 s
+    DriverInputs cycle;
+    cycle.acStatus = true;
+    cycle.acTemp = 22;
+    cycle.windLevel = 2;
+    Vehicle efficient(profile, cycle);
+    while (efficient.clock.getTime() < CYCLES * CYCLE_SECONDS) {
+        efficient.clock.tick();
+        int second = static_cast<int>(efficient.clock.getTime()) % CYCLE_SECONDS;
+        cycle.isAccelerator = second < 30;
+        cycle.isBrake = second >= 50 && second < 60;
+        efficient.simulation.step(cycle);
+    }
+    double capacity = profile.getDesignValue(VehicleAttribute::BATTERY_CAPACITY);
+    double distance = efficient.speedCalculator.getTotalDistance();
+    if (distance > 0.0) {
+        result.kwhPerKm = (capacity - efficient.batteryManager.getBatteryKwH()) / distance;
+        result.range = result.kwhPerKm > 0.0 ? capacity / result.kwhPerKm : 0.0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    VehicleBrand brand = VehicleBrand::TESLA;
+    VehicleOption option = VehicleOption::LONG_RANGE;
+    size_t threads = std::thread::hardware_concurrency();
+    std::string csvPath;
+    std::vector<SweepRange> ranges;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--threads") {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (i + 1 < argc && arg == "--csv") {
+            csvPath = argv[++i];
+        } else if (i + 1 < argc && arg == "--base") {
+            std::string base = argv[++i];
+            if (base == "tesla-standard")               { brand = VehicleBrand::TESLA;   option = VehicleOption::STANDAND; }
+            else if (base == "tesla-long-range")        { brand = VehicleBrand::TESLA;   option = VehicleOption::LONG_RANGE; }
+            else if (base == "ioniq5")                  { brand = VehicleBrand::HYUNDAI; option = VehicleOption::STANDAND; }
+            else if (base == "ioniq5-performance")      { brand = VehicleBrand::HYUNDAI; option = VehicleOption::PERFORMANCE; }
+            else {
+                std::cerr << "Unknown base profile: " << base << std::endl;
+                return 1;
+            }
+        } else {
+            SweepRange range;
+            if (!parseRange(arg, range)) {
+                std::cerr << "Expected ATTRIBUTE=min:max:step with positive 16-bit values, got: " << arg << std::endl;
+                return 1;
+            }
+            ranges.push_back(range);
+        }
+    }
+    if (ranges.empty()) {
+        ranges = {{VehicleAttribute::BATTERY_CAPACITY, 50, 100, 10}, {VehicleAttribute::MAX_TORQUE, 300, 700, 100},
+                  {VehicleAttribute::WEIGHT, 1500, 2300, 200}, {VehicleAttribute::WHEEL_RADIUS, 32, 38, 2}};
+    }
+    if (threads < 1) threads = 1;
+
+    size_t combinations = 1;
+    for (const SweepRange& range : ranges) {
+        combinations *= range.count();
+        if (combinations > MAX_COMBINATIONS) {
+            std::cerr << "More than " << MAX_COMBINATIONS << " combinations, narrow the ranges" << std::endl;
+            return 1;
+        }
+    }
+    std::shared_ptr<const VehicleProfile> base = VehicleProfile::create(brand, option);
+    if (!base) {
+        return 1;
+    }
+
+    // Design values of one combination, the first range varying slowest
+    auto paramsOf = [&](size_t index) {
+        vehicleBaseParam params = base->baseParam;
+        for (size_t r = ranges.size(); r-- > 0;) {
+            const SweepRange& range = ranges[r];
+            params.set(range.attribute, static_cast<designValue>(range.min + range.step * (index % range.count())));
+            index /= range.count();
+        }
+        return params;
+    };
+
+    // Tables depend on MAX_RPM, MAX_TORQUE and WHEEL_RADIUS only; build each distinct set once
+    auto start = std::chrono::steady_clock::now();
+    using TablesKey = std::tuple<int, int, int>;
+    std::map<TablesKey, std::shared_ptr<const ProfileTables>> tables;
+    std::vector<TablesKey> keys(combinations);
+    for (size_t i = 0; i < combinations; i++) {
+        vehicleBaseParam params = paramsOf(i);
+        keys[i] = TablesKey(params[VehicleAttribute::MAX_RPM], params[VehicleAttribute::MAX_TORQUE],
+                            params[VehicleAttribute::WHEEL_RADIUS]);
+        if (!tables.count(keys[i])) {
+            tables[keys[i]] = std::make_shared<const ProfileTables>(std::get<0>(keys[i]), std::get<1>(keys[i]),
+                                                                    std::get<2>(keys[i]));
+        }
+    }
+
+    std::vector<SweepResult> results(combinations);
+    ThreadPool pool(threads);
+    pool.parallelFor(combinations, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            results[i] = evaluate(*VehicleProfile::create(brand, option, paramsOf(i), tables.at(keys[i])));
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath);
+        if (!csv) {
+            std::cerr << "Failed to open " << csvPath << std::endl;
+            return 1;
+        }
+        for (const SweepRange& range : ranges) csv << attributeName(range.attribute) << ",";
+        csv << "zero_to_100_s,top_speed_kmh,kwh_per_km,range_km\n";
+    }
+    for (const SweepRange& range : ranges) std::cout << std::setw(18) << attributeName(range.attribute);
+    std::cout << "   0-100 s  top km/h    kWh/km  range km" << std::endl;
+    for (size_t i = 0; i < combinations; i++) {
+        vehicleBaseParam params = paramsOf(i);
+        const SweepResult& result = results[i];
+        for (const SweepRange& range : ranges) {
+            std::cout << std::setw(18) << params[range.attribute];
+            if (csv.is_open()) csv << params[range.attribute] << ",";
+        }
+        std::cout << std::fixed << std::setw(10) << std::setprecision(2) << result.zeroTo100 << std::setw(10)
+                  << result.topSpeed << std::setw(10) << std::setprecision(3) << result.kwhPerKm << std::setw(10)
+                  << std::setprecision(1) << result.range << std::endl;
+        if (csv.is_open()) {
+            csv << result.zeroTo100 << "," << result.topSpeed << "," << result.kwhPerKm << "," << result.range << "\n";
+        }
+    }
+    std::cout << combinations << " configurations (" << tables.size() << " distinct torque tables) in "
+              << std::setprecision(2) << seconds << " s on " << pool.getThreadCount() << " threads = "
+              << std::setprecision(1) << combinations / seconds << " configurations/s, "
+              << static_cast<long>((LAUNCH_SECONDS + CYCLES * CYCLE_SECONDS) / SimulationClock::DEFAULT_STEP)
+              << " ticks each" << std::endl;
+    return 0;
+}
@@ -0,0 +1,241 @@
+// Drives a vehicle from a full battery until it is empty and compares the
+// range estimates of the lifetime EMA, the energy map and the median of the
+// Monte Carlo distribution with the distance actually driven afterwards,
+// once every simulated minute. For the Monte Carlo estimate it also counts
+// how often that distance fell between its P10 and P90.
+//
+//     ./RangeEval [--samples N] [--threads N]                          all synthetic scenarios
+//     ./RangeEval [--samples N] [--threads N] ../data/Trip.telemetry   the recorded inputs, looped until the battery is empty
+#include "BatteryManager.h"
+#include "MonteCarloRange.h"
+#include "TelemetryRecorder.h"
+#include "ThreadPool.h"
+#include "VehicleConfig.h"
+#include "VehicleSimulation.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const double TICK_SECONDS = 0.06;
+static const double MAX_HOURS = 12.0;
+static const double MIN_BATTERY = 5.0;     // %, below this the estimates are not scored
+static const double LAST_KM = 100.0;       // the part of the trip scored separately
+static const size_t REFRESH_SHARE = 8;     // Monte Carlo samples re-simulated per minute: 1 / REFRESH_SHARE
+
+using InputSchedule = std::function<DriverInputs(double seconds)>;
+
+static uint64_t simulatedSamples = 0;
+
+struct Estimate {
+    double odometer;
+    double batteryLevel;
+    double ema;
+    double energyMap;
+    RangePercentiles monteCarlo;
+};
+
+struct Score {
+    double absolute = 0.0;
+    double relative = 0.0;
+    double lastAbsolute = 0.0;
+    int count = 0;
+    int lastCount = 0;
+    int covered = 0;        // truths between P10 and P90
+
+    void add(double estimate, double truth) {
+        double error = std::abs(estimate - truth);
+        absolute += error;
+        relative += truth > 1.0 ? error / truth : 0.0;
+        count++;
+        if (truth < LAST_KM) {
+            lastAbsolute += error;
+            lastCount++;
+        }
+    }
+};
+
+// 70 s stop-and-go cycle: accelerate 30 s, coast 20 s, brake 10 s, idle 10 s
+static DriverInputs stopAndGo(double seconds, DriveMode::Mode mode) {
+    int cycleSecond = static_cast<int>(seconds) % 70;
+    DriverInputs inputs;
+    inputs.driveMode = mode;
+    inputs.isAccelerator = cycleSecond < 30;
+    inputs.isBrake = cycleSecond >= 50 && cycleSecond < 60;
+    return inputs;
+}
+
+// Short pulls between stops: accelerate 3 s, coast 9 s, brake 5 s, idle 3 s
+static DriverInputs city(double seconds) {
+    int cycleSecond = static_cast<int>(seconds) % 20;
+    DriverInputs inputs;
+    inputs.isAccelerator = cycleSecond < 3;
+    inputs.isBrake = cycleSecond >= 12 && cycleSecond < 17;
+    return inputs;
+}
+
+// Cruising at the mode's top speed, a short lift every ten minutes
+static DriverInputs highway(double seconds) {
+    DriverInputs inputs;
+    inputs.isAccelerator = static_cast<int>(seconds) % 600 < 590;
+    return inputs;
+}
+
+static DriverInputs withAc(DriverInputs inputs, int acTemp, int windLevel) {
+    inputs.acStatus = true;
+    inputs.acTemp = acTemp;
+    inputs.windLevel = windLevel;
+    return inputs;
+}
+
+// Inputs of a recorded trip, repeated from the start when it runs out
+static InputSchedule loopSamples(const std::vector<TelemetrySample>& samples) {
+    return [&samples](double seconds) {
+        int64_t length = samples.back().timestampMicros - samples.front().timestampMicros + 60000;
+        int64_t offset = static_cast<int64_t>(seconds * 1e6) % length + samples.front().timestampMicros;
+        size_t lower = 0, upper = samples.size();
+        while (upper - lower > 1) {
+            size_t middle = (lower + upper) / 2;
+            if (samples[middle].timestampMicros <= offset) lower = middle; else upper = middle;
+        }
+        const TelemetrySample& sample = samples[lower];
+        return unpackInputFlags(sample.inputFlags, sample.acTemp, sample.windLevel);
+    };
+}
+
+// Drives until the battery is empty; false if MAX_HOURS are not enough
+static bool drive(const InputSchedule& schedule, MonteCarloRange& monteCarlo, std::vector<Estimate>& estimates,
+                  double& emptyOdometer, double& hours) {
+    SimulationClock clock(SimulationClock::Mode::FIXED_STEP);
+    DriveMode driveMode;
+    SafetyManager safetyManager;
+    SpeedCalculator speedCalculator(&driveMode, &safetyManager, &clock);
+    BatteryManager batteryManager(&speedCalculator, &clock);
+    VehicleSimulation simulation(&driveMode, &safetyManager, &speedCalculator, &batteryManager, schedule(0.0));
+
+    int nextMinute = 0;
+    while (clock.getTime() < MAX_HOURS * 3600.0) {
+        clock.advance(TICK_SECONDS);
+        DriverInputs inputs = schedule(clock.getTime());
+        const VehicleState& state = simulation.step(inputs);
+        monteCarlo.observe(inputs, state.speed, TICK_SECONDS);
+        if (batteryManager.getBatteryKwH() <= 0.0) {
+            emptyOdometer = state.odometer;
+            hours = clock.getTime() / 3600.0;
+            return true;
+        }
+        if (clock.getTime() >= nextMinute * 60.0) {
+            size_t samples = monteCarlo.getSampleCount();
+            monteCarlo.refresh(nextMinute == 0 ? samples : std::max<size_t>(samples / REFRESH_SHARE, 1));
+            estimates.push_back({state.odometer, state.batteryLevel, batteryManager.calculateEmaRange(),
+                                 state.remainingRange, monteCarlo.estimate(batteryManager.getBatteryKwH())});
+            nextMinute++;
+        }
+    }
+    return false;
+}
+
+static void evaluate(const std::string& name, const InputSchedule& schedule, ThreadPool& pool, size_t samples) {
+    std::vector<Estimate> estimates;
+    double emptyOdometer = 0.0;
+    double hours = 0.0;
+    MonteCarloRange monteCarlo(ElectricVehicleInit::getProfile(), samples, &pool);
+    bool empty = drive(schedule, monteCarlo, estimates, emptyOdometer, hours);
+    simulatedSamples += monteCarlo.getSimulations();
+    if (!empty) {
+        std::cout << std::left << std::setw(16) << name << "battery not empty after " << MAX_HOURS << " h, skipped"
+                  << std::endl;
+        return;
+    }
+
+    Score ema, energyMap, median;
+    for (const Estimate& estimate : estimates) {
+        if (estimate.batteryLevel < MIN_BATTERY) break;
+        double truth = emptyOdometer - estimate.odometer;
+        ema.add(estimate.ema, truth);
+        energyMap.add(estimate.energyMap, truth);
+        median.add(estimate.monteCarlo.p50, truth);
+        median.covered += truth >= estimate.monteCarlo.p10 && truth <= estimate.monteCarlo.p90;
+    }
+    if (ema.count == 0) {
+        std::cout << std::left << std::setw(16) << name << "no estimates to score" << std::endl;
+        return;
+    }
+    auto print = [&](const char* model, const Score& score) {
+        std::cout << std::left << std::setw(16) << name << std::setw(14) << model << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(1) << emptyOdometer << std::setw(7) << std::setprecision(2)
+                  << hours << std::setw(10) << std::setprecision(1)
+                  << score.absolute / score.count << std::setw(9) << score.relative / score.count * 100.0
+                  << std::setw(14) << (score.lastCount ? score.lastAbsolute / score.lastCount : 0.0);
+    };
+    print("ema", ema);
+    std::cout << std::setw(11) << "-" << std::endl;
+    print("energy map", energyMap);
+    std::cout << std::setw(11) << "-" << std::endl;
+    print("monte carlo", median);
+    std::cout << std::setw(11) << 100.0 * median.covered / median.count << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ElectricVehicleInit::load(*VehicleProfile::create(VehicleBrand::TESLA, VehicleOption::LONG_RANGE));
+
+    size_t monteCarloSamples = MonteCarloRange::DEFAULT_SAMPLES;
+    size_t threads = std::thread::hardware_concurrency();
+    std::string telemetryPath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) {
+            monteCarloSamples = std::max<size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max<size_t>(std::strtoul(argv[++i], nullptr, 10), 1);
+        } else {
+            telemetryPath = arg;
+        }
+    }
+    ThreadPool pool(std::max<size_t>(threads, 1));
+
+    std::vector<TelemetrySample> samples;
+    if (!telemetryPath.empty()) {
+        TelemetryReader reader(telemetryPath);
+        if (!reader.isOpen()) {
+            return 1;
+        }
+        reader.readAll(samples);
+        if (samples.size() < 2) {
+            std::cerr << "Not enough samples to replay" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Estimates every simulated minute above " << MIN_BATTERY << " % battery, " << TICK_SECONDS * 1000
+              << " ms ticks; Monte Carlo: " << monteCarloSamples << " samples of " << MonteCarloRange::HORIZON_SECONDS
+              << " s, 1/" << REFRESH_SHARE << " refreshed per minute" << std::endl;
+    std::cout << "scenario        model          trip km  hours    MAE km   MAPE %  MAE last " << LAST_KM
+              << " km  P10-P90 %" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!samples.empty()) {
+        evaluate("recorded trip", loopSamples(samples), pool, monteCarloSamples);
+    } else {
+        // The ReplayTrip --synthetic cycle
+        evaluate("stop-and-go", [](double s) {
+            return withAc(stopAndGo(s, static_cast<int>(s / 3600) % 2 ? DriveMode::Mode::SPORT : DriveMode::Mode::ECO),
+                          22, 2);
+        }, pool, monteCarloSamples);
+        evaluate("city-highway", [](double s) { return s < 3600.0 ? city(s) : highway(s); }, pool, monteCarloSamples);
+        evaluate("highway-city", [](double s) { return s < 1200.0 ? highway(s) : city(s); }, pool, monteCarloSamples);
+        evaluate("ac-midway", [](double s) {
+            DriverInputs inputs = city(s);
+            return s < 3600.0 ? inputs : withAc(inputs, 16, 5);
+        }, pool, monteCarloSamples);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Monte Carlo: " << simulatedSamples << " sample drives in " << std::setprecision(2) << seconds
+              << " s on " << pool.getThreadCount() << " threads = " << std::setprecision(0)
+              << simulatedSamples / seconds << " samples/s" << std::endl;
+    return 0;
+}
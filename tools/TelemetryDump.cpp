@@ -0,0 +1,52 @@
+// Prints a summary of a trip telemetry log, or every sample with --csv.
+//
+//     ./TelemetryDump ../data/Trip.telemetry [--csv]
+#include "TelemetryRecorder.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <telemetry file> [--csv]" << std::endl;
+        return 1;
+    }
+    bool csv = argc > 2 && std::string(argv[2]) == "--csv";
+
+    TelemetryReader reader(argv[1]);
+    if (!reader.isOpen()) {
+        return 1;
+    }
+
+    std::vector<TelemetrySample> samples;
+    reader.readAll(samples);
+    if (reader.isTruncated()) {
+        std::cerr << "Log ends in a torn block, showing the samples before it" << std::endl;
+    }
+
+    if (csv) {
+        std::cout << "timestamp_us,speed,gas,brake,inputs,ac_temp,wind,power_w,kwh,battery_temp,odometer" << std::endl;
+        for (const auto& s : samples) {
+            std::cout << s.timestampMicros << ',' << s.speed << ',' << s.gasIntensity << ',' << s.brakeIntensity << ','
+                      << s.inputFlags << ',' << s.acTemp << ',' << s.windLevel << ',' << s.powerConsumption << ','
+                      << s.currentKwH << ',' << s.batteryTemp << ',' << s.odometer << '\n';
+        }
+        return 0;
+    }
+
+    std::cout << "Samples: " << samples.size() << std::endl;
+    if (samples.empty()) {
+        return 0;
+    }
+    const auto& first = samples.front();
+    const auto& last = samples.back();
+    int maxSpeed = 0;
+    for (const auto& s : samples) {
+        if (s.speed > maxSpeed) maxSpeed = s.speed;
+    }
+    std::cout << "Duration: " << (last.timestampMicros - first.timestampMicros) / 1e6 << " s" << std::endl;
+    std::cout << "Distance: " << last.odometer - first.odometer << " km" << std::endl;
+    std::cout << "Energy used: " << first.currentKwH - last.currentKwH << " kWh" << std::endl;
+    std::cout << "Max speed: " << maxSpeed << " km/h" << std::endl;
+    std::cout << "Battery temp: " << first.batteryTemp << " -> " << last.batteryTemp << " C" << std::endl;
+    return 0;
+}